@@ -28,7 +28,13 @@ namespace embree
     __forceinline void parallel_for( const Index N, const Func& func)
   {
 #if defined(TASKING_INTERNAL)
-    if (N) {
+    if (N && TaskScheduler::host()) {
+      TaskScheduler::spawn_host(Index(0),N,Index(1),[&] (const range<Index>& r) {
+          for (Index i=r.begin(); i<r.end(); i++)
+            func(i);
+        });
+    }
+    else if (N) {
       TaskScheduler::spawn(Index(0),N,Index(1),[&] (const range<Index>& r) {
           assert(r.size() == 1);
           func(r.begin());
@@ -59,6 +65,10 @@ namespace embree
   {
     assert(first <= last);
 #if defined(TASKING_INTERNAL)
+    if (TaskScheduler::host()) {
+      if (first < last) TaskScheduler::spawn_host(first,last,minStepSize,func);
+      return;
+    }
     TaskScheduler::spawn(first,last,minStepSize,func);
     if (!TaskScheduler::wait())
       throw std::runtime_error("task cancelled");
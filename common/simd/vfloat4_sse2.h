@@ -395,6 +395,22 @@ namespace embree
 #endif
   }
 
+  /*! converts 4 IEEE half floats to single precision, denormal halfs are flushed to zero */
+  __forceinline vfloat4 convert_from_hf16(const unsigned short* ptr)
+  {
+#if defined(__aarch64__)
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(ptr)));
+#elif defined(__AVX_I__)
+    return _mm_cvtph_ps(_mm_loadl_epi64((__m128i*)ptr));
+#else
+    const vint4 h = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i*)ptr),_mm_setzero_si128());
+    const vint4 em = h & vint4(0x7fff);
+    const vfloat4 f = asFloat(em << 13) * asFloat(vint4(0x77800000)); // rebias exponent by 2^112
+    const vfloat4 r = select(em >= vint4(0x7c00),asFloat((em << 13) | vint4(0x7f800000)),f);
+    return asFloat(_mm_castps_si128(r) | ((h & vint4(0x8000)) << 16));
+#endif
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   /// Movement/Shifting/Shuffling Functions
   ////////////////////////////////////////////////////////////////////////////////
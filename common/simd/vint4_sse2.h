@@ -109,6 +109,18 @@ namespace embree
       return  _mm_cvtepu8_epi32(_mm_loadu_si128((__m128i*)ptr));
     }
 
+#else
+
+    static __forceinline vint4 load( const unsigned char* const ptr ) {
+      return loadu(ptr);
+    }
+
+    static __forceinline vint4 loadu( const unsigned char* const ptr ) {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i x = _mm_cvtsi32_si128(*(const int*)ptr);
+      return _mm_unpacklo_epi16(_mm_unpacklo_epi8(x,zero),zero);
+    }
+
 #endif
 
     static __forceinline vint4 load(const unsigned short* const ptr) {
@@ -17,6 +17,7 @@
 #include "config.h"
 #include "alloc.h"
 #include "intrinsics.h"
+#include "sysinfo.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Windows Platform
@@ -51,7 +52,7 @@ namespace embree
 
   size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld) 
   {
-    size_t pageSize = 4096;
+    size_t pageSize = getPageSize();
     bytesNew = (bytesNew+pageSize-1) & ~(pageSize-1);
     assert(bytesNew <= bytesOld);
     if (bytesNew < bytesOld)
@@ -64,6 +65,60 @@ namespace embree
     if (!VirtualFree(ptr,0,MEM_RELEASE))
       /*throw std::bad_alloc()*/ return;  // we on purpose do not throw an exception when an error occurs, to avoid throwing an exception during error handling
   }
+
+  /* the page file backs all memory on windows */
+  void* os_map_tmpfile(size_t bytes) {
+    return os_malloc(bytes);
+  }
+
+  void os_unmap_tmpfile(void* ptr, size_t bytes) {
+    os_free(ptr,bytes);
+  }
+
+  void os_discard(void* ptr, size_t bytes) {
+    if (bytes == 0) return;
+    VirtualAlloc(ptr,bytes,MEM_RESET,PAGE_READWRITE);
+  }
+
+  void* os_map_file(const char* fileName, size_t offset, size_t bytes)
+  {
+    HANDLE file = CreateFile(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER fileSize;
+    const size_t pageSize = getPageSize();
+    if (bytes == 0 || !GetFileSizeEx(file,&fileSize) || offset+bytes > ((size_t(fileSize.QuadPart)+pageSize-1) & ~(pageSize-1))) {
+      CloseHandle(file);
+      return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMapping(file,nullptr,PAGE_READONLY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+
+    /* views have to start at a multiple of the allocation granularity and end inside the file */
+    SYSTEM_INFO info; GetSystemInfo(&info);
+    const size_t base = offset - offset % info.dwAllocationGranularity;
+    const size_t end = offset+bytes < size_t(fileSize.QuadPart) ? offset+bytes : size_t(fileSize.QuadPart);
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_READ,DWORD(base >> 32),DWORD(base),end-base);
+    CloseHandle(mapping); // the view keeps the mapping alive
+    if (ptr == nullptr) return nullptr;
+    return (char*)ptr + (offset-base);
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr) return;
+    SYSTEM_INFO info; GetSystemInfo(&info);
+    UnmapViewOfFile((void*)((size_t)ptr & ~size_t(info.dwAllocationGranularity-1)));
+  }
+
+  void os_advise(void* ptr, size_t bytes, bool sequential) {
+  }
+
+  /* windows can only select the NUMA node when the memory gets allocated */
+  void os_bind_numa(void* ptr, size_t bytes, size_t node) {
+  }
 }
 #endif
 
@@ -74,25 +129,37 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
-#define UPGRADE_TO_2M_PAGE_LIMIT (256*1024) 
-#define PAGE_SIZE_2M (2*1024*1024)
-#define PAGE_SIZE_4K (4*1024)
+#if defined(__LINUX__)
+#include <sys/syscall.h>
+#if defined(__USE_NUMA__)
+#include <numa.h>
+#endif
+#endif
 
 namespace embree
 {
+  /* page sizes are queried at runtime as aarch64 kernels also use 16KB and 64KB base pages */
+  __forceinline size_t alignToPageSize(const size_t bytes, const size_t pageSize) {
+    return (bytes+pageSize-1) & ~(pageSize-1);
+  }
+
   __forceinline bool isHugePageCandidate(const size_t bytes) 
   {
     /* try to use huge pages for large allocations */
-    if (bytes >= PAGE_SIZE_2M)
+    const size_t hugePageSize = getHugePageSize();
+    if (bytes >= hugePageSize)
     {
       /* multiple of page size */
-      if ((bytes % PAGE_SIZE_2M) == 0) 
+      if ((bytes % hugePageSize) == 0) 
         return true;
-      else if (bytes >= 64 * PAGE_SIZE_2M) /* will only introduce a 3% overhead */
+      else if (bytes >= 64 * hugePageSize) /* will only introduce a 3% overhead */
         return true;
     }
     return false;
@@ -116,7 +183,7 @@ namespace embree
         
     if (isHugePageCandidate(bytes)) 
     {
-      bytes = (bytes+PAGE_SIZE_2M-1)&ssize_t(-PAGE_SIZE_2M);
+      bytes = alignToPageSize(bytes,getHugePageSize());
 #if !defined(__MACOSX__)
       /* try direct huge page allocation first */
       if (tryDirectHugePageAllocation)
@@ -141,7 +208,7 @@ namespace embree
 #endif
     } 
     else
-      bytes = (bytes+PAGE_SIZE_4K-1)&ssize_t(-PAGE_SIZE_4K);
+      bytes = alignToPageSize(bytes,getPageSize());
 
     /* standard mmap call */
     void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
@@ -165,8 +232,8 @@ namespace embree
 
   size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld) 
   {
-    /* first try with 4KB pages */
-    bytesNew = (bytesNew+PAGE_SIZE_4K-1) & ~(PAGE_SIZE_4K-1);
+    /* first try with base pages */
+    bytesNew = alignToPageSize(bytesNew,getPageSize());
     assert(bytesNew <= bytesOld);
     if (bytesNew >= bytesOld)
       return bytesOld;
@@ -174,14 +241,14 @@ namespace embree
     if (munmap((char*)ptr+bytesNew,bytesOld-bytesNew) != -1)
       return bytesNew;
 
-    /* now try with 2MB pages */
-    bytesNew = (bytesNew+PAGE_SIZE_2M-1) & ~(PAGE_SIZE_2M-1);
+    /* now try with huge pages */
+    bytesNew = alignToPageSize(bytesNew,getHugePageSize());
     assert(bytesNew <= bytesOld);
     if (bytesNew >= bytesOld)
       return bytesOld;
 
     if (munmap((char*)ptr+bytesNew,bytesOld-bytesNew) != -1)
-      return bytesNew; // this may be too small in case we really used 2MB pages
+      return bytesNew; // this may be too small in case we really used huge pages
 
     throw std::bad_alloc();
   }
@@ -191,14 +258,109 @@ namespace embree
     if (bytes == 0)
       return;
 
-    size_t pageSize = PAGE_SIZE_4K;
+    size_t pageSize = getPageSize();
     if (isHugePageCandidate(bytes)) 
-      pageSize = PAGE_SIZE_2M;
+      pageSize = getHugePageSize();
 
-    bytes = (bytes+pageSize-1)&ssize_t(-pageSize);
+    bytes = alignToPageSize(bytes,pageSize);
     if (munmap(ptr,bytes) == -1)
       /*throw std::bad_alloc()*/ return;  // we on purpose do not throw an exception when an error occurs, to avoid throwing an exception during error handling
   }
+
+  void* os_map_tmpfile(size_t bytes)
+  {
+    const char* tmpdir = getenv("TMPDIR");
+    std::string fileName = std::string(tmpdir ? tmpdir : "/tmp") + "/embreeXXXXXX";
+    int fd = mkstemp(&fileName[0]);
+    if (fd == -1) throw std::bad_alloc();
+
+    /* the file stays alive as long as it is mapped */
+    unlink(fileName.c_str());
+    bytes = alignToPageSize(bytes,getPageSize());
+    if (ftruncate(fd,bytes) == -1) {
+      close(fd);
+      throw std::bad_alloc();
+    }
+    void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == nullptr || ptr == MAP_FAILED) throw std::bad_alloc();
+    return ptr;
+  }
+
+  void os_unmap_tmpfile(void* ptr, size_t bytes)
+  {
+    if (bytes == 0) return;
+    bytes = alignToPageSize(bytes,getPageSize());
+    munmap(ptr,bytes);
+  }
+
+  void os_discard(void* ptr, size_t bytes)
+  {
+    /* only pages completely inside the range can get released */
+    const size_t pageSize = getPageSize();
+    char* begin = (char*) alignToPageSize((size_t)ptr,pageSize);
+    char* end   = (char*) (((size_t)ptr+bytes) & ~(pageSize-1));
+    if (begin >= end) return;
+#if defined(MADV_REMOVE)
+    /* also frees the backing store of file mappings */
+    if (madvise(begin,end-begin,MADV_REMOVE) == 0) return;
+#endif
+    madvise(begin,end-begin,MADV_DONTNEED);
+  }
+
+  void* os_map_file(const char* fileName, size_t offset, size_t bytes)
+  {
+    const int fd = open(fileName,O_RDONLY);
+    if (fd == -1) return nullptr;
+
+    /* pages that are completely behind the end of the file cannot get accessed */
+    struct stat info;
+    const size_t pageSize = getPageSize();
+    if (bytes == 0 || fstat(fd,&info) != 0 || offset+bytes > alignToPageSize(size_t(info.st_size),pageSize)) {
+      close(fd);
+      return nullptr;
+    }
+    
+    const size_t base = offset & ~(pageSize-1);
+    void* ptr = mmap(nullptr,offset+bytes-base,PROT_READ,MAP_SHARED,fd,base);
+    close(fd); // the mapping keeps the file alive
+    if (ptr == nullptr || ptr == MAP_FAILED) return nullptr;
+    return (char*)ptr + (offset-base);
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr) return;
+    char* base = (char*) ((size_t)ptr & ~(getPageSize()-1));
+    munmap(base,(char*)ptr+bytes-base);
+  }
+
+  void os_advise(void* ptr, size_t bytes, bool sequential)
+  {
+    if (ptr == nullptr || bytes == 0) return;
+    char* base = (char*) ((size_t)ptr & ~(getPageSize()-1));
+    madvise(base,(char*)ptr+bytes-base,sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+  }
+
+  void os_bind_numa(void* ptr, size_t bytes, size_t node)
+  {
+#if defined(__LINUX__)
+    if (bytes == 0 || getNumberOfNumaNodes() <= 1) return;
+    const size_t pageSize = getPageSize();
+    char* begin = (char*) ((size_t)ptr & ~(pageSize-1));
+    const size_t size = alignToPageSize((char*)ptr+bytes-begin,pageSize);
+#if defined(__USE_NUMA__)
+    numa_tonode_memory(begin,size,int(node));
+#else
+    /* the physical pages get allocated on first touch, thus setting a preferred policy is sufficient */
+    const int MPOL_PREFERRED_ = 1;
+    unsigned long nodeMask[16] = { 0 };
+    if (node >= 8*sizeof(nodeMask)) return;
+    nodeMask[node/(8*sizeof(unsigned long))] = 1ul << (node%(8*sizeof(unsigned long)));
+    syscall(SYS_mbind,begin,size,MPOL_PREFERRED_,nodeMask,8*sizeof(nodeMask),0); // failures are ignored as the policy is a hint only
+#endif
+#endif
+  }
 }
 
 #endif
@@ -82,6 +82,29 @@ namespace embree
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld);
   void  os_free   (void* ptr, size_t bytes);
 
+  /*! maps memory that is backed by a temporary file, thus the OS can
+   *  page it out under memory pressure, the file is removed when the
+   *  memory gets unmapped */
+  void* os_map_tmpfile  (size_t bytes);
+  void  os_unmap_tmpfile(void* ptr, size_t bytes);
+
+  /*! releases the physical pages of some memory range, the content of the range is lost */
+  void  os_discard(void* ptr, size_t bytes);
+
+  /*! maps bytes of a file starting at offset read-only into memory,
+   *  the range may extend past the end of the file up to the end of
+   *  its last page, returns nullptr if the range cannot get mapped */
+  void* os_map_file  (const char* fileName, size_t offset, size_t bytes);
+  void  os_unmap_file(void* ptr, size_t bytes);
+
+  /*! hints that some mapped memory range gets accessed sequentially or randomly */
+  void  os_advise(void* ptr, size_t bytes, bool sequential);
+
+  /*! prefers physical pages of the specified NUMA node for a not yet
+   *  touched memory range, is a hint only and ignored on systems
+   *  without NUMA support */
+  void  os_bind_numa(void* ptr, size_t bytes, size_t node);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
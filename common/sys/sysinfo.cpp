@@ -18,6 +18,11 @@
 #include "intrinsics.h"
 #include "string.h"
 
+#if defined(__aarch64__) && defined(__LINUX__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// All Platforms
 ////////////////////////////////////////////////////////////////////////////////
@@ -152,7 +157,13 @@ namespace embree
 
   int getCPUFeatures()
   {
-     return CPU_FEATURE_NEON|CPU_FEATURE_SSE2|CPU_FEATURE_SSE;
+    int cpu_features = CPU_FEATURE_NEON|CPU_FEATURE_SSE2|CPU_FEATURE_SSE;
+#if defined(__aarch64__) && defined(__LINUX__)
+    /* ARMv8.2 half precision arithmetic is optional, ask the kernel */
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    if ((hwcap & HWCAP_FPHP) && (hwcap & HWCAP_ASIMDHP)) cpu_features |= CPU_FEATURE_FP16;
+#endif
+    return cpu_features;
   }
 
   std::string stringOfCPUFeatures(int features)
@@ -183,6 +194,7 @@ namespace embree
     if (features & CPU_FEATURE_AVX512VL) str += "AVX512VL ";
     if (features & CPU_FEATURE_AVX512IFMA) str += "AVX512IFMA ";
     if (features & CPU_FEATURE_AVX512VBMI) str += "AVX512VBMI ";
+    if (features & CPU_FEATURE_FP16) str += "FP16 ";
     if (features & CPU_FEATURE_NEON) str += "NEON ";
     return str;
   }
@@ -273,6 +285,45 @@ namespace embree
     return nThreads;
   }
 
+  size_t getPageSize()
+  {
+    static size_t pageSize = 0;
+    if (pageSize) return pageSize;
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+    pageSize = sysinfo.dwPageSize;
+    return pageSize;
+  }
+
+  size_t getHugePageSize()
+  {
+    static size_t hugePageSize = 0;
+    if (hugePageSize) return hugePageSize;
+    hugePageSize = GetLargePageMinimum();
+    if (hugePageSize == 0) hugePageSize = 2*1024*1024;
+    return hugePageSize;
+  }
+
+  size_t getNumberOfNumaNodes()
+  {
+    static size_t numNodes = 0;
+    if (numNodes) return numNodes;
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) highestNode = 0;
+    numNodes = size_t(highestNode)+1;
+    return numNodes;
+  }
+
+  size_t getNumaNode()
+  {
+    static __thread ssize_t node = -1;
+    if (node >= 0) return node;
+    UCHAR n = 0;
+    if (!GetNumaProcessorNode((UCHAR)GetCurrentProcessorNumber(),&n)) n = 0;
+    node = n;
+    return node;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -304,6 +355,11 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
+
+#if defined(__USE_NUMA__)
+#include <numa.h>
+#endif
 
 namespace embree
 {
@@ -315,6 +371,87 @@ namespace embree
     if (bytes != -1) buf[bytes] = '\0';
     return std::string(buf);
   }
+
+  size_t getHugePageSize()
+  {
+    static size_t hugePageSize = 0;
+    if (hugePageSize) return hugePageSize;
+
+    /* size of transparent huge pages, depends on the base page size of the kernel */
+    unsigned long long bytes = 0;
+    if (FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size","r")) {
+      if (fscanf(file,"%llu",&bytes) != 1) bytes = 0;
+      fclose(file);
+    }
+
+    /* otherwise use default size of explicit huge pages */
+    if (bytes == 0) {
+      if (FILE* file = fopen("/proc/meminfo","r")) {
+        char line[256];
+        while (fgets(line,sizeof(line),file)) {
+          if (sscanf(line,"Hugepagesize: %llu kB",&bytes) == 1) { bytes *= 1024; break; }
+        }
+        fclose(file);
+      }
+    }
+
+    hugePageSize = bytes ? size_t(bytes) : size_t(2*1024*1024);
+    return hugePageSize;
+  }
+
+#if defined(__USE_NUMA__)
+
+  size_t getNumberOfNumaNodes()
+  {
+    static size_t numNodes = 0;
+    if (numNodes) return numNodes;
+    const int n = numa_available() >= 0 ? numa_num_configured_nodes() : 1;
+    numNodes = n > 1 ? size_t(n) : size_t(1);
+    return numNodes;
+  }
+
+  size_t getNumaNode()
+  {
+    static __thread ssize_t node = -1;
+    if (node >= 0) return node;
+    const int cpu = sched_getcpu();
+    const int n = (cpu >= 0 && numa_available() >= 0) ? numa_node_of_cpu(cpu) : 0;
+    node = n > 0 ? n : 0;
+    return node;
+  }
+
+#else
+
+  size_t getNumberOfNumaNodes()
+  {
+    static size_t numNodes = 0;
+    if (numNodes) return numNodes;
+    char path[64];
+    size_t n = 0;
+    for (; n<1024; n++) {
+      sprintf(path,"/sys/devices/system/node/node%d",int(n));
+      if (access(path,F_OK) != 0) break;
+    }
+    numNodes = n ? n : 1;
+    return numNodes;
+  }
+
+  size_t getNumaNode()
+  {
+    static __thread ssize_t node = -1;
+    if (node >= 0) return node;
+    node = 0;
+    const int cpu = sched_getcpu();
+    if (cpu < 0) return node;
+    char path[64];
+    for (size_t i=0; i<getNumberOfNumaNodes(); i++) {
+      sprintf(path,"/sys/devices/system/cpu/cpu%d/node%d",cpu,int(i));
+      if (access(path,F_OK) == 0) { node = i; break; }
+    }
+    return node;
+  }
+
+#endif
 }
 
 #endif
@@ -381,6 +518,29 @@ namespace embree
     return nThreads;
   }
 
+  size_t getPageSize()
+  {
+    static size_t pageSize = 0;
+    if (pageSize) return pageSize;
+    const long bytes = sysconf(_SC_PAGESIZE);
+    pageSize = bytes > 0 ? size_t(bytes) : size_t(4096);
+    return pageSize;
+  }
+
+#if !defined(__LINUX__)
+  size_t getHugePageSize() {
+    return 2*1024*1024;
+  }
+
+  size_t getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  size_t getNumaNode() {
+    return 0;
+  }
+#endif
+
   int getTerminalWidth() 
   {
     struct winsize info;
@@ -18,10 +18,6 @@
 
 #define CACHELINE_SIZE 64
 
-#if !defined(PAGE_SIZE)
-  #define PAGE_SIZE 4096
-#endif
-
 #define MAX_THREADS 512
 #define MAX_MIC_CORES (MAX_THREADS/4)
 
@@ -148,6 +144,7 @@ namespace embree
   static const int CPU_FEATURE_AVX512VL = 1 << 22;
   static const int CPU_FEATURE_AVX512IFMA = 1 << 23;
   static const int CPU_FEATURE_AVX512VBMI = 1 << 24;
+  static const int CPU_FEATURE_FP16 = 1 << 25;
   static const int CPU_FEATURE_NEON = 1 << 31; 
   /*! get CPU features */
   int getCPUFeatures();
@@ -178,6 +175,19 @@ namespace embree
 
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
+
+  /*! returns the size of a memory page of the system in bytes */
+  size_t getPageSize();
+
+  /*! returns the size of a (transparent) huge page of the system in bytes */
+  size_t getHugePageSize();
+
+  /*! returns the number of NUMA nodes of the system */
+  size_t getNumberOfNumaNodes();
+
+  /*! returns the NUMA node the calling thread runs on, the node is
+   *  queried once per thread as threads stay pinned to their cores */
+  size_t getNumaNode();
   
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
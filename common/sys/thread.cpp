@@ -172,35 +172,205 @@ namespace embree
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <sched.h>
 
 namespace embree
 {
-  /* changes thread ID mapping such that we first fill up all thread on one core */
-  size_t mapThreadID(size_t threadID)
+  /*! reads a single integer from a sysfs file */
+  static ssize_t readSysfsInt(const std::string& file, ssize_t defaultValue)
   {
-    static MutexSys mutex;
-    Lock<MutexSys> lock(mutex);
-    static std::vector<size_t> threadIDs;
+    std::fstream fs;
+    fs.open (file.c_str(), std::fstream::in);
+    if (fs.fail()) return defaultValue;
+    ssize_t value = defaultValue;
+    if (!(fs >> value)) value = defaultValue;
+    return value;
+  }
 
-    if (threadIDs.size() == 0)
+  /*! parses CPU lists of the form 0-3,8,10-11 */
+  static std::vector<size_t> parseCPUList(const std::string& file)
+  {
+    std::vector<size_t> cpus;
+    std::fstream fs;
+    fs.open (file.c_str(), std::fstream::in);
+    if (fs.fail()) return cpus;
+
+    size_t first;
+    while (fs >> first) 
+    {
+      size_t last = first;
+      if (fs.peek() == '-') {
+        fs.ignore();
+        if (!(fs >> last)) last = first;
+      }
+      for (size_t i=first; i<=last; i++) cpus.push_back(i);
+      if (fs.peek() == ',') 
+        fs.ignore();
+    }
+    return cpus;
+  }
+
+  /*! CPU topology as reported by sysfs */
+  struct CPUTopology
+  {
+    struct CPU
     {
-      /* parse thread/CPU topology */
+      size_t id;        //!< logical CPU ID
+      size_t node;      //!< NUMA node
+      size_t package;   //!< physical package (socket)
+      ssize_t cluster;  //!< cluster ID, -1 if the kernel does not report clusters
+      size_t capacity;  //!< relative compute capacity, 1024 for the fastest cores
+      size_t core;      //!< core ID inside the package
+      size_t clusterIndex; //!< dense index of the (node,package,cluster,capacity) group
+      size_t socketIndex;  //!< dense index of the (node,package) group
+    };
+
+    CPUTopology ()
+    {
+      const std::string sysfs = "/sys/devices/system/cpu/cpu";
       for (size_t cpuID=0;;cpuID++)
       {
-        std::fstream fs;
-        std::string cpu = std::string("/sys/devices/system/cpu/cpu") + std::to_string((long long)cpuID) + std::string("/topology/thread_siblings_list");
-        fs.open (cpu.c_str(), std::fstream::in);
-        if (fs.fail()) break;
-
-        int i;
-        while (fs >> i) 
-        {
-          if (std::none_of(threadIDs.begin(),threadIDs.end(),[&] (int id) { return id == i; }))
-            threadIDs.push_back(i);
-          if (fs.peek() == ',') 
-            fs.ignore();
+        const std::string dir = sysfs + std::to_string((long long)cpuID);
+        const ssize_t package = readSysfsInt(dir + "/topology/physical_package_id",-1);
+        if (package < 0) break;
+
+        CPU cpu;
+        cpu.id = cpuID;
+        cpu.node = 0;
+        cpu.package = package;
+        cpu.cluster = readSysfsInt(dir + "/topology/cluster_id",-1);
+        cpu.capacity = readSysfsInt(dir + "/cpu_capacity",1024);
+        cpu.core = readSysfsInt(dir + "/topology/core_id",cpuID);
+        cpus.push_back(cpu);
+      }
+
+      /* NUMA nodes list their CPUs */
+      for (size_t nodeID=0; nodeID<cpus.size(); nodeID++)
+      {
+        const std::vector<size_t> nodeCPUs = parseCPUList("/sys/devices/system/node/node" + std::to_string((long long)nodeID) + "/cpulist");
+        for (size_t i=0; i<nodeCPUs.size(); i++)
+          for (size_t j=0; j<cpus.size(); j++)
+            if (cpus[j].id == nodeCPUs[i]) cpus[j].node = nodeID;
+      }
+
+      /* kernels without cluster_id still separate big and little clusters by capacity */
+      for (size_t i=0; i<cpus.size(); i++)
+      {
+        cpus[i].clusterIndex = cpus[i].socketIndex = i;
+        for (size_t j=0; j<i; j++) {
+          if (sameSocket(cpus[i],cpus[j])) cpus[i].socketIndex = std::min(cpus[i].socketIndex,cpus[j].socketIndex);
+          if (sameCluster(cpus[i],cpus[j])) cpus[i].clusterIndex = std::min(cpus[i].clusterIndex,cpus[j].clusterIndex);
         }
-        fs.close();
+      }
+    }
+
+    static bool sameSocket(const CPU& a, const CPU& b) {
+      return a.node == b.node && a.package == b.package;
+    }
+
+    static bool sameCluster(const CPU& a, const CPU& b) {
+      return sameSocket(a,b) && a.cluster == b.cluster && a.capacity == b.capacity;
+    }
+
+    /*! orders sockets by NUMA node, the highest capacity clusters first inside each socket, and SMT siblings next to each other */
+    std::vector<size_t> compactOrder() const
+    {
+      std::vector<CPU> sorted = cpus;
+      std::stable_sort(sorted.begin(),sorted.end(),[] (const CPU& a, const CPU& b) {
+          if (a.socketIndex != b.socketIndex) return a.socketIndex < b.socketIndex;
+          if (a.capacity != b.capacity) return a.capacity > b.capacity;
+          if (a.clusterIndex != b.clusterIndex) return a.clusterIndex < b.clusterIndex;
+          return a.core < b.core;
+        });
+      std::vector<size_t> order;
+      for (size_t i=0; i<sorted.size(); i++) order.push_back(sorted[i].id);
+      return order;
+    }
+
+    /*! round robin over the sockets, each socket in compact order */
+    std::vector<size_t> scatterOrder() const
+    {
+      const std::vector<size_t> compact = compactOrder();
+      std::vector<std::vector<size_t>> sockets;
+      for (size_t i=0; i<compact.size(); i++) {
+        const size_t socket = find(compact[i])->socketIndex;
+        size_t k=0; while (k<sockets.size() && find(sockets[k][0])->socketIndex != socket) k++;
+        if (k == sockets.size()) sockets.push_back(std::vector<size_t>());
+        sockets[k].push_back(compact[i]);
+      }
+      std::vector<size_t> order;
+      for (size_t i=0; order.size()<compact.size(); i++)
+        for (size_t k=0; k<sockets.size(); k++)
+          if (i < sockets[k].size()) order.push_back(sockets[k][i]);
+      return order;
+    }
+
+    const CPU* find(size_t cpuID) const 
+    {
+      for (size_t i=0; i<cpus.size(); i++)
+        if (cpus[i].id == cpuID) return &cpus[i];
+      return nullptr;
+    }
+
+    std::vector<CPU> cpus;
+  };
+
+  static MutexSys g_topology_mutex;
+  static ThreadAffinityPolicy g_affinity_policy = AFFINITY_SMT;
+  static std::vector<size_t> g_threadIDs;
+
+  static const CPUTopology& getCPUTopology()
+  {
+    static CPUTopology topology; // parsed once, the constructor is thread safe
+    return topology;
+  }
+
+  /*! fills up all threads on one core first, cores in sysfs order */
+  static std::vector<size_t> smtOrder()
+  {
+    std::vector<size_t> threadIDs;
+
+    /* parse thread/CPU topology */
+    for (size_t cpuID=0;;cpuID++)
+    {
+      std::fstream fs;
+      std::string cpu = std::string("/sys/devices/system/cpu/cpu") + std::to_string((long long)cpuID) + std::string("/topology/thread_siblings_list");
+      fs.open (cpu.c_str(), std::fstream::in);
+      if (fs.fail()) break;
+
+      int i;
+      while (fs >> i) 
+      {
+        if (std::none_of(threadIDs.begin(),threadIDs.end(),[&] (int id) { return id == i; }))
+          threadIDs.push_back(i);
+        if (fs.peek() == ',') 
+          fs.ignore();
+      }
+      fs.close();
+    }
+    return threadIDs;
+  }
+
+  void setAffinityPolicy(ThreadAffinityPolicy policy)
+  {
+    Lock<MutexSys> lock(g_topology_mutex);
+    if (policy == g_affinity_policy) return;
+    g_affinity_policy = policy;
+    g_threadIDs.clear();
+  }
+
+  /* changes thread ID mapping according to the affinity policy, by default we first fill up all thread on one core */
+  size_t mapThreadID(size_t threadID)
+  {
+    Lock<MutexSys> lock(g_topology_mutex);
+    std::vector<size_t>& threadIDs = g_threadIDs;
+
+    if (threadIDs.size() == 0)
+    {
+      switch (g_affinity_policy) {
+      case AFFINITY_SMT    : threadIDs = smtOrder(); break;
+      case AFFINITY_COMPACT: threadIDs = getCPUTopology().compactOrder(); break;
+      case AFFINITY_SCATTER: threadIDs = getCPUTopology().scatterOrder(); break;
       }
 
 #if 0
@@ -226,6 +396,17 @@ namespace embree
     return ID;
   }
 
+  void getThreadLocation(size_t& cluster, size_t& socket)
+  {
+    cluster = socket = 0;
+    const int cpuID = sched_getcpu();
+    if (cpuID < 0) return;
+    const CPUTopology::CPU* cpu = getCPUTopology().find(cpuID);
+    if (!cpu) return;
+    cluster = cpu->clusterIndex;
+    socket = cpu->socketIndex;
+  }
+
   /*! set affinity of the calling thread */
   void setAffinity(ssize_t affinity)
   {
@@ -239,6 +420,20 @@ namespace embree
 }
 #endif
 
+#if !defined(__LINUX__)
+
+namespace embree
+{
+  /*! topology aware placement is only implemented on Linux */
+  void setAffinityPolicy(ThreadAffinityPolicy policy) {
+  }
+
+  void getThreadLocation(size_t& cluster, size_t& socket) {
+    cluster = socket = 0;
+  }
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// FreeBSD Platform
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,20 @@ namespace embree
   /*! set affinity of the calling thread */
   void setAffinity(ssize_t affinity);
 
+  /*! policies to map thread IDs to logical CPUs when affinity is enabled */
+  enum ThreadAffinityPolicy
+  {
+    AFFINITY_SMT     = 0, //!< fills up all hardware threads of a core first, cores in sysfs order
+    AFFINITY_COMPACT = 1, //!< fills up the highest capacity clusters of a socket first, then the next socket
+    AFFINITY_SCATTER = 2  //!< distributes threads round robin over the sockets
+  };
+
+  /*! selects the policy used for all threads created afterwards */
+  void setAffinityPolicy(ThreadAffinityPolicy policy);
+
+  /*! returns the cluster and socket of the CPU the calling thread runs on */
+  void getThreadLocation(size_t& cluster, size_t& socket);
+
   /*! the thread calling this function gets yielded */
   void yield();
 
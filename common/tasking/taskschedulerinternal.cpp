@@ -25,6 +25,8 @@ namespace embree
   __thread TaskScheduler* TaskScheduler::g_instance = nullptr;
   __thread TaskScheduler::Thread* TaskScheduler::thread_local_thread = nullptr;
   TaskScheduler::ThreadPool* TaskScheduler::threadPool = nullptr;
+  TaskScheduler::HostInterface TaskScheduler::g_host_interface;
+  const TaskScheduler::HostInterface* TaskScheduler::g_host = nullptr;
 
   template<typename Predicate, typename Body>
   __forceinline void TaskScheduler::steal_loop(Thread& thread, const Predicate& pred, const Body& body)
@@ -240,15 +242,31 @@ namespace embree
 
   __dllexport size_t TaskScheduler::threadIndex() 
   {
+    if (g_host) return g_host->threadIndex(g_host->userPtr);
     Thread* thread = TaskScheduler::thread();
     if (thread) return thread->threadIndex;
     else        return 0;
   }
 
   __dllexport size_t TaskScheduler::threadCount() {
+    if (g_host) return g_host->threadCount;
     return threadPool->size();
   }
 
+  __dllexport const TaskScheduler::HostInterface* TaskScheduler::host() {
+    return g_host;
+  }
+
+  __dllexport void TaskScheduler::setHostInterface(const HostInterface* host)
+  {
+    if (host) {
+      g_host_interface = *host;
+      g_host = &g_host_interface;
+    } else {
+      g_host = nullptr;
+    }
+  }
+
   __dllexport TaskScheduler* TaskScheduler::instance() 
   {
     if (g_instance == NULL) {
@@ -365,18 +383,26 @@ namespace embree
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++) 
+    /* steal inside the own cluster first, then inside the own socket, and only then from other sockets */
+    for (size_t distance=0; distance<3; distance++)
     {
-      __pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+      for (size_t i=1; i<threadCount; i++) 
+      {
+        size_t otherThreadIndex = threadIndex+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
 
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread)
+          continue;
 
-      if (othread->tasks.steal(thread)) 
-        return true;      
+        const size_t d = othread->socket != thread.socket ? 2 : othread->cluster != thread.cluster ? 1 : 0;
+        if (d != distance)
+          continue;
+
+        __pause_cpu(32);
+        if (othread->tasks.steal(thread)) 
+          return true;      
+      }
     }
 
     return false;
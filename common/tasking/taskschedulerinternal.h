@@ -181,7 +181,9 @@ namespace embree
       ALIGNED_STRUCT;
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {
+        getThreadLocation(cluster,socket);
+      }
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
@@ -191,6 +193,8 @@ namespace embree
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
+      size_t cluster;                  //!< CPU cluster this thread runs on
+      size_t socket;                   //!< CPU socket this thread runs on
     };
 
     /*! pool of worker threads */
@@ -233,6 +237,25 @@ namespace embree
     TaskScheduler ();
     ~TaskScheduler ();
 
+    /*! tasking system of the host application that replaces the internal thread pool */
+    struct HostInterface
+    {
+      typedef void (*TaskFunc)(void* taskPtr, size_t begin, size_t end);
+      typedef void (*ParallelForFunc)(void* userPtr, size_t begin, size_t end, size_t blockSize, TaskFunc task, void* taskPtr);
+      typedef size_t (*ThreadIndexFunc)(void* userPtr);
+
+      ParallelForFunc parallelFor;   //!< executes task for all blocks of [begin,end) and returns when all finished
+      ThreadIndexFunc threadIndex;   //!< returns index of calling host thread in [0,threadCount)
+      size_t threadCount;            //!< number of threads of the host tasking system
+      void* userPtr;                 //!< passed to all callbacks
+    };
+
+    /*! registers the tasking system of the host application, nullptr returns to the internal thread pool */
+    __dllexport static void setHostInterface(const HostInterface* host);
+
+    /*! returns the registered host tasking system or nullptr */
+    __dllexport static const HostInterface* host();
+
     /*! initializes the task scheduler */
     static void create(size_t numThreads, bool set_affinity, bool start_threads);
 
@@ -332,6 +355,41 @@ namespace embree
 	});
     }
 
+    /* executes a task set on the host tasking system, exceptions are forwarded to the caller */
+    template<typename Index, typename Closure>
+    static void spawn_host(const Index begin, const Index end, const Index blockSize, const Closure& closure) 
+    {
+      struct HostTask
+      {
+        HostTask (const Closure& closure) 
+          : closure(closure), cancelled(false), except(nullptr) {}
+
+        static void run(void* ptr, size_t begin, size_t end)
+        {
+          HostTask* task = (HostTask*) ptr;
+          if (task->cancelled) return;
+          try {
+            task->closure(range<Index>(Index(begin),Index(end)));
+          } catch (...) {
+            Lock<SpinLock> lock(task->mutex);
+            if (task->except == nullptr) task->except = std::current_exception();
+            task->cancelled = true;
+          }
+        }
+
+        const Closure& closure;
+        std::atomic<bool> cancelled;
+        std::exception_ptr except;
+        SpinLock mutex;
+      };
+
+      HostTask task(closure);
+      const HostInterface* hostInterface = host();
+      hostInterface->parallelFor(hostInterface->userPtr,size_t(begin),size_t(end),blockSize > Index(0) ? size_t(blockSize) : size_t(1),HostTask::run,&task);
+      if (task.except != nullptr) 
+        std::rethrow_exception(task.except);
+    }
+
     /* work on spawned subtasks and wait until all have finished */
     __dllexport static bool wait();
 
@@ -375,6 +433,8 @@ namespace embree
     static __thread TaskScheduler* g_instance;
     static __thread Thread* thread_local_thread;
     static ThreadPool* threadPool;
+    static HostInterface g_host_interface;
+    static const HostInterface* g_host;
   };
 };
 
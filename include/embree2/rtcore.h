@@ -239,6 +239,33 @@ RTCORE_API RTCORE_DEPRECATED void rtcSetMemoryMonitorFunction(RTCMemoryMonitorFu
  *  called before or after the library allocates or frees memory. */
 RTCORE_API void rtcDeviceSetMemoryMonitorFunction(RTCDevice device, RTCMemoryMonitorFunc func);
 
+/*! \brief Type of a task set executed by the host tasking system. */
+typedef void (*RTCTaskFunc)(void* taskPtr, size_t begin, size_t end);
+
+/*! \brief Type of the host callback that executes a task set. The
+ *  callback has to invoke task for disjoint blocks that cover
+ *  [begin,end), preferably of blockSize elements, and has to return
+ *  after all blocks finished. Tasks may invoke the callback again. */
+typedef void (*RTCParallelForFunc)(void* userPtr, size_t begin, size_t end, size_t blockSize, RTCTaskFunc task, void* taskPtr);
+
+/*! \brief Type of the host callback returning the index of the
+ *  calling thread. */
+typedef size_t (*RTCThreadIndexFunc)(void* userPtr);
+
+/*! \brief Tasking system of the host application. */
+struct RTCTaskingInterface
+{
+  RTCParallelForFunc parallelFor;   //!< executes a task set
+  RTCThreadIndexFunc threadIndex;   //!< returns index of calling thread in [0,threadCount)
+  size_t threadCount;               //!< number of threads of the host tasking system
+  void* userPtr;                    //!< passed to all callbacks
+};
+
+/*! \brief Lets Embree execute all parallel work on the tasking
+ *  system of the host application instead of its internal threads.
+ *  Passing NULL returns to the internal threads. */
+RTCORE_API void rtcDeviceSetTaskingInterface(RTCDevice device, const RTCTaskingInterface* tasking);
+
 /*! \brief Implementation specific (do not call).
 
   This function is implementation specific and only for debugging
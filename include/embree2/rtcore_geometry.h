@@ -385,6 +385,23 @@ RTCORE_API void rtcUnmapBuffer(RTCScene scene, unsigned geomID, RTCBufferType ty
 RTCORE_API void rtcSetBuffer(RTCScene scene, unsigned geomID, RTCBufferType type, 
                              const void* ptr, size_t byteOffset, size_t byteStride);
 
+/*! \brief Shares a range of a file as data buffer. 
+
+  Embree maps the file read-only into memory and directly uses the
+  mapped memory as the specified buffer, thus data does not get
+  copied and pages get loaded from disk on demand. The buffer
+  consists of num elements starting at byteOffset inside the file
+  with byteStride bytes between the elements, and num has to be at
+  least the number of elements of the buffer. The layout
+  requirements of rtcSetBuffer apply, the 4 bytes after the last
+  vertex of a vertex buffer have to be inside the file or inside the
+  last page of the file. The mapping gets released when the geometry
+  gets deleted or a new buffer of the same type gets set. Mapped
+  buffers are accessed sequentially during build and randomly during
+  rendering, which Embree passes on as hints to the OS. */
+RTCORE_API void rtcSetFileBuffer(RTCScene scene, unsigned geomID, RTCBufferType type, 
+                                 const char* fileName, size_t byteOffset, size_t byteStride, size_t num);
+
 /*! \brief Enable geometry. Enabled geometry can be hit by a ray. */
 RTCORE_API void rtcEnable (RTCScene scene, unsigned geomID);
 
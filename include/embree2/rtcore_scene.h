@@ -69,6 +69,30 @@ struct RTCIntersectContext
   void* userRayExt;          //!< can be used to pass extended ray data to callbacks
 };
 
+/*! memory consumption of a scene or one of its acceleration structures in bytes */
+struct RTCMemoryStatistics
+{
+  const char* name;          //!< name of the acceleration structure, NULL for the entire scene
+  size_t innerNodes;         //!< inner nodes of the hierarchies
+  size_t leaves;             //!< leaf primitive blocks
+  size_t primRefs;           //!< peak of temporary build data during the last commit
+  size_t tessellationCache;  //!< tessellation cache used by the subdivision meshes of the scene
+  size_t halfEdges;          //!< half edge structures of the subdivision meshes of the scene
+  size_t wasted;             //!< allocator memory neither used by the hierarchies nor free for later builds
+  size_t free;               //!< allocator memory kept for later rebuilds
+  size_t total;              //!< sum of all categories
+};
+
+/*! statistics of the tessellation cache used by a scene */
+struct RTCTessellationCacheStatistics
+{
+  size_t hits;               //!< patch lookups that found valid tessellation data
+  size_t misses;             //!< patch lookups that had to tessellate
+  size_t flushes;            //!< switches to the next cache segment, each evicting the oldest data
+  size_t bytes;              //!< size of the cache
+  size_t allocatedBytes;     //!< tessellation data written into the cache
+};
+
 /*! \brief Defines an opaque scene type */
 typedef struct __RTCScene {}* RTCScene;
 
@@ -87,6 +111,28 @@ RTCORE_DEPRECATED typedef RTCProgressMonitorFunc RTC_PROGRESS_MONITOR_FUNCTION;
 /*! \brief Sets the progress callback function which is called during hierarchy build of this scene. */
 RTCORE_API void rtcSetProgressMonitorFunction(RTCScene scene, RTCProgressMonitorFunc func, void* ptr);
 
+/*! Sets a memory budget in bytes for the hierarchies of the scene
+ *  including the peak of their temporary build data. On commit the
+ *  default triangle acceleration structure falls back to more compact
+ *  layouts (no spatial splits, then indexed triangles, then for
+ *  static scenes quantized nodes) until the scene fits the budget. If
+ *  the most compact layout still exceeds the budget, the commit fails
+ *  with RTC_OUT_OF_MEMORY. A budget of 0 disables this behaviour,
+ *  which is the default. */
+RTCORE_API void rtcSetMemoryBudget(RTCScene scene, size_t bytes);
+
+/*! Gives the scene its own tessellation cache of the specified size
+ *  in bytes, such that its subdivision patches do not evict the
+ *  patches of other scenes. A size of 0 returns to the tessellation
+ *  cache shared by all scenes, which is the default. The size must
+ *  not get changed while rays are traced. */
+RTCORE_API void rtcSetTessellationCacheSize(RTCScene scene, size_t bytes);
+
+/*! Returns the statistics of the tessellation cache used by the
+ *  scene. For the shared cache the statistics are accumulated over
+ *  all scenes using it. */
+RTCORE_API void rtcGetTessellationCacheStatistics(RTCScene scene, RTCTessellationCacheStatistics& stats_o);
+
 /*! Commits the geometry of the scene. After initializing or modifying
  *  geometries, commit has to get called before tracing
  *  rays. */
@@ -104,6 +150,19 @@ RTCORE_API void rtcCommit (RTCScene scene);
  *  coprocessor. */
 RTCORE_API void rtcCommitThread(RTCScene scene, unsigned int threadID, unsigned int numThreads);
 
+/*! Commits the geometry of a static scene like rtcCommit and stores
+ *  the built hierarchies to the specified file. Only triangle, quad,
+ *  and hair geometry is supported, using the default acceleration
+ *  structures. */
+RTCORE_API void rtcSaveBVH(RTCScene scene, const char* filename);
+
+/*! Commits the geometry of a static scene by loading the hierarchies
+ *  from a file previously written by rtcSaveBVH. The file is
+ *  validated against the geometry buffers of the scene, if it does
+ *  not exist or does not match the scene, the scene is built as
+ *  with rtcCommit. */
+RTCORE_API void rtcLoadBVH(RTCScene scene, const char* filename);
+
 /*! Returns AABB of the scene. rtcCommit has to get called
  *  previously to this function. */
 RTCORE_API void rtcGetBounds(RTCScene scene, RTCBounds& bounds_o);
@@ -113,6 +172,24 @@ RTCORE_API void rtcGetBounds(RTCScene scene, RTCBounds& bounds_o);
  *  previously to this function. */
 RTCORE_API void rtcGetLinearBounds(RTCScene scene, RTCBounds* bounds_o);
 
+/*! Returns the number of acceleration structures of the scene that
+ *  can be queried with rtcGetAccelMemoryStatistics. rtcCommit has to
+ *  get called previously to this function. */
+RTCORE_API size_t rtcGetNumAccels(RTCScene scene);
+
+/*! Returns the memory consumption of the entire scene, broken down
+ *  by category. The node and leaf sizes are gathered by traversing
+ *  the hierarchies, thus this function should not get called per
+ *  frame. rtcCommit has to get called previously to this
+ *  function. */
+RTCORE_API void rtcGetMemoryStatistics(RTCScene scene, RTCMemoryStatistics& stats_o);
+
+/*! Returns the memory consumption of the acceleration structure
+ *  accelID of the scene, the tessellation cache and half edge
+ *  categories are only reported for the entire scene. rtcCommit has
+ *  to get called previously to this function. */
+RTCORE_API void rtcGetAccelMemoryStatistics(RTCScene scene, size_t accelID, RTCMemoryStatistics& stats_o);
+
 /*! Intersects a single ray with the scene. The ray has to be aligned
  *  to 16 bytes. This function can only be called for scenes with the
  *  RTC_INTERSECT1 flag set. */
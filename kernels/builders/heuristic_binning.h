@@ -73,6 +73,18 @@ namespace embree
           return Vec3ia(floori((vfloat4(p)-ofs)*scale));
         }
 
+        /*! bins 4 points at once, returns bin IDs of all points per dimension */
+        __forceinline void bin4(const Vec3fa& p0, const Vec3fa& p1, const Vec3fa& p2, const Vec3fa& p3, vint4& binX, vint4& binY, vint4& binZ) const
+        {
+          vfloat4 x,y,z; transpose(vfloat4(p0),vfloat4(p1),vfloat4(p2),vfloat4(p3),x,y,z);
+          binX = floori((x-shuffle<0>(ofs))*shuffle<0>(scale));
+          binY = floori((y-shuffle<1>(ofs))*shuffle<1>(scale));
+          binZ = floori((z-shuffle<2>(ofs))*shuffle<2>(scale));
+          assert(all(binX >= 0) && all(binX < vint4(int(num))));
+          assert(all(binY >= 0) && all(binY < vint4(int(num))));
+          assert(all(binZ >= 0) && all(binZ < vint4(int(num))));
+        }
+
         /*! returns true if the mapping is invalid in some dimension */
         __forceinline bool invalid(const size_t dim) const {
           return scale[dim] == 0.0f;
@@ -178,50 +190,41 @@ namespace embree
       {
 	if (unlikely(N == 0)) return;
 	size_t i; 
-	for (i=0; i<N-1; i+=2)
+	for (i=0; i+4<=N; i+=4)
         {
-          /*! map even and odd primitive to bin */
-          BBox prim0; Vec3fa center0;
-          prims[i+0].binBoundsAndCenter(prim0,center0); 
-          const vint4 bin0 = (vint4)mapping.bin(center0); 
+          /*! map blocks of 4 primitives to bins */
+          BBox prim0; Vec3fa center0; prims[i+0].binBoundsAndCenter(prim0,center0); 
+          BBox prim1; Vec3fa center1; prims[i+1].binBoundsAndCenter(prim1,center1); 
+          BBox prim2; Vec3fa center2; prims[i+2].binBoundsAndCenter(prim2,center2); 
+          BBox prim3; Vec3fa center3; prims[i+3].binBoundsAndCenter(prim3,center3); 
+          vint4 binX, binY, binZ; mapping.bin4(center0,center1,center2,center3,binX,binY,binZ);
           
-          BBox prim1; Vec3fa center1;
-          prims[i+1].binBoundsAndCenter(prim1,center1); 
-          const vint4 bin1 = (vint4)mapping.bin(center1); 
-          
-          /*! increase bounds for bins for even primitive */
-          const unsigned int b00 = extract<0>(bin0); bounds(b00,0).extend(prim0); 
-          const unsigned int b01 = extract<1>(bin0); bounds(b01,1).extend(prim0); 
-          const unsigned int b02 = extract<2>(bin0); bounds(b02,2).extend(prim0); 
-
-          counts(b00,0)++;
-          counts(b01,1)++;
-          counts(b02,2)++;
-
-          /*! increase bounds of bins for odd primitive */
-          const unsigned int b10 = extract<0>(bin1);  bounds(b10,0).extend(prim1); 
-          const unsigned int b11 = extract<1>(bin1);  bounds(b11,1).extend(prim1); 
-          const unsigned int b12 = extract<2>(bin1);  bounds(b12,2).extend(prim1); 
-
-          counts(b10,0)++;
-          counts(b11,1)++;
-          counts(b12,2)++;
+          /*! increase bounds of bins for each primitive */
+          binPrim(prim0,extract<0>(binX),extract<0>(binY),extract<0>(binZ));
+          binPrim(prim1,extract<1>(binX),extract<1>(binY),extract<1>(binZ));
+          binPrim(prim2,extract<2>(binX),extract<2>(binY),extract<2>(binZ));
+          binPrim(prim3,extract<3>(binX),extract<3>(binY),extract<3>(binZ));
         }
-	/*! for uneven number of primitives */
-	if (i < N)
+
+	/*! for remaining primitives */
+	for (; i<N; i++)
         {
           /*! map primitive to bin */
           BBox prim0; Vec3fa center0;
           prims[i].binBoundsAndCenter(prim0,center0); 
           const vint4 bin0 = (vint4)mapping.bin(center0); 
-          
-          /*! increase bounds of bins */
-          const int b00 = extract<0>(bin0); counts(b00,0)++; bounds(b00,0).extend(prim0);
-          const int b01 = extract<1>(bin0); counts(b01,1)++; bounds(b01,1).extend(prim0);
-          const int b02 = extract<2>(bin0); counts(b02,2)++; bounds(b02,2).extend(prim0);
+          binPrim(prim0,extract<0>(bin0),extract<1>(bin0),extract<2>(bin0));
         }
       }
 
+      /*! increase bounds and counts of bins of some primitive */
+      __forceinline void binPrim(const BBox& prim, const unsigned int b0, const unsigned int b1, const unsigned int b2)
+      {
+        counts(b0,0)++; bounds(b0,0).extend(prim);
+        counts(b1,1)++; bounds(b1,1).extend(prim);
+        counts(b2,2)++; bounds(b2,2).extend(prim);
+      }
+
       /*! bins an array of primitives */
       __forceinline void bin (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping, const AffineSpace3fa& space)
       {
@@ -89,7 +89,9 @@ namespace embree
           Binner binner(empty);
           const BinMapping<BINS> mapping(pinfo);
           const BinMapping<BINS>& _mapping = mapping; // CLANG 3.4 parser bug workaround
-          binner = parallel_reduce(set.begin(),set.end(),PARALLEL_FIND_BLOCK_SIZE,binner,
+          /* bin into few private bin sets per thread to keep the number of merges low */
+          const size_t blockSize = max(PARALLEL_FIND_BLOCK_SIZE,set.size()/(4*TaskScheduler::threadCount()));
+          binner = parallel_reduce(set.begin(),set.end(),blockSize,binner,
 			  [&](const range<size_t>& r) -> Binner { Binner binner(empty); binner.bin(prims + r.begin(), r.size(), _mapping); return binner; },
 			  [&](const Binner& b0, const Binner& b1) -> Binner { Binner r = b0; r.merge(b1, _mapping.size()); return r; });
 		  return binner.best(mapping,logBlockSize);
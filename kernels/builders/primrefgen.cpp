@@ -265,6 +265,88 @@ namespace embree
       return pinfo;
     }
 
+    template<typename Mesh>
+    PrimInfo createPrimRefChunks(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor)
+    {
+      static const unsigned int CELLS_PER_DIM = 16;
+      static const unsigned int NUM_CELLS = CELLS_PER_DIM*CELLS_PER_DIM*CELLS_PER_DIM;
+      Scene::Iterator<Mesh,false> iter(scene);
+      progressMonitor(0);
+
+      /* first pass computes centroid bounds of all valid primitives */
+      PrimInfo pinfo = parallel_for_for_reduce( iter, size_t(1024), PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k) -> PrimInfo
+      {
+        PrimInfo pinfo(empty);
+        for (size_t j=r.begin(); j<r.end(); j++)
+        {
+          BBox3fa bounds = empty;
+          if (!mesh->buildBounds(j,&bounds)) continue;
+          pinfo.add(bounds,bounds.center2());
+        }
+        return pinfo;
+      }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+      chunks.clear();
+      prims = nullptr;
+      if (pinfo.size() == 0) 
+        return pinfo;
+
+      /* primitives are sorted into the cells of a regular grid over the centroid bounds, cells are enumerated in morton order */
+      const vfloat4 ofs = (vfloat4) pinfo.centBounds.lower;
+      const vfloat4 diag = (vfloat4) pinfo.centBounds.size();
+      const vfloat4 scale = select(diag > vfloat4(1E-34f),vfloat4(0.99f*CELLS_PER_DIM)/diag,vfloat4(0.0f));
+      auto cellID = [&] (const BBox3fa& bounds) -> unsigned int {
+        const vint4 c = clamp(floori(((vfloat4)bounds.center2()-ofs)*scale),vint4(0),vint4(CELLS_PER_DIM-1));
+        return bitInterleave(unsigned(c[0]),unsigned(c[1]),unsigned(c[2]));
+      };
+
+      /* second pass counts primitives per cell */
+      std::vector<std::atomic<size_t>> cellCounts(NUM_CELLS);
+      for (size_t i=0; i<NUM_CELLS; i++) cellCounts[i] = 0;
+      parallel_for_for( iter, size_t(64*1024), [&](Mesh* mesh, const range<size_t>& r, size_t k)
+      {
+        std::vector<size_t> counts(NUM_CELLS,0);
+        for (size_t j=r.begin(); j<r.end(); j++)
+        {
+          BBox3fa bounds = empty;
+          if (!mesh->buildBounds(j,&bounds)) continue;
+          counts[cellID(bounds)]++;
+        }
+        for (size_t i=0; i<NUM_CELLS; i++)
+          if (counts[i]) cellCounts[i] += counts[i];
+      });
+
+      /* group consecutive cells into chunks, a single cell may exceed the chunk size */
+      std::vector<std::atomic<size_t>> cellOffsets(NUM_CELLS);
+      size_t offset = 0, chunkBegin = 0;
+      for (size_t i=0; i<NUM_CELLS; i++)
+      {
+        const size_t count = cellCounts[i];
+        if (offset > chunkBegin && offset+count-chunkBegin > maxChunkSize) {
+          chunks.push_back(range<size_t>(chunkBegin,offset));
+          chunkBegin = offset;
+        }
+        cellOffsets[i] = offset;
+        offset += count;
+      }
+      if (offset > chunkBegin) chunks.push_back(range<size_t>(chunkBegin,offset));
+      assert(offset == pinfo.size());
+
+      /* third pass writes primitive references into the file backed array */
+      prims = (PrimRef*) os_map_tmpfile(pinfo.size()*sizeof(PrimRef));
+      progressMonitor(0);
+      parallel_for_for( iter, size_t(64*1024), [&](Mesh* mesh, const range<size_t>& r, size_t k)
+      {
+        for (size_t j=r.begin(); j<r.end(); j++)
+        {
+          BBox3fa bounds = empty;
+          if (!mesh->buildBounds(j,&bounds)) continue;
+          prims[cellOffsets[cellID(bounds)]++] = PrimRef(bounds,mesh->id,unsigned(j));
+        }
+      });
+      return pinfo;
+    }
+
     template PrimInfo createPrimRefArray<TriangleMesh>(TriangleMesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<QuadMesh>(QuadMesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<BezierCurves>(BezierCurves* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
@@ -282,6 +364,12 @@ namespace embree
     template PrimInfo createPrimRefArray<AccelSet,false>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet,true>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    template PrimInfo createPrimRefChunks<TriangleMesh>(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefChunks<QuadMesh>(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefChunks<BezierCurves>(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefChunks<LineSegments>(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefChunks<AccelSet>(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor);
+
     template PrimInfo createPrimRefArrayMBlur<TriangleMesh>(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArrayMBlur<QuadMesh>(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     //template PrimInfo createPrimRefArrayMBlur<BezierCurves>(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
@@ -34,6 +34,14 @@ namespace embree
     template<typename Mesh>
       PrimInfo createPrimRefArrayMBlur(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    /*! Creates the primitive references of all meshes of a scene and
+     *  sorts them into spatially coherent chunks of at most
+     *  maxChunkSize references. The references are stored in memory
+     *  backed by a temporary file, which has to get released using
+     *  os_unmap_tmpfile(prims,pinfo.size()*sizeof(PrimRef)). */
+    template<typename Mesh>
+      PrimInfo createPrimRefChunks(Scene* scene, PrimRef*& prims, std::vector<range<size_t>>& chunks, const size_t maxChunkSize, BuildProgressMonitor& progressMonitor);
+
     PrimInfo createBezierRefArray(Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
     PrimInfo createBezierRefArrayMBlur(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
   }
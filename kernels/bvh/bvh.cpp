@@ -23,11 +23,12 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(primTy), device(scene->device), scene(scene),
-      root(emptyNode), msmblur(false), numTimeSteps(1), alloc(scene->device), numPrimitives(0), numVertices(0) {}
+      root(emptyNode), msmblur(false), numTimeSteps(1), alloc(scene->device,scene->device->numa_alloc,scene->device->alloc_retain_factor), buildMonitor(scene->device), numPrimitives(0), numVertices(0) {}
 
   template<int N>
   BVHN<N>::~BVHN ()
   {
+    clearNumaReplicas();
     for (size_t i=0; i<objects.size(); i++) 
       delete objects[i];
   }
@@ -42,17 +43,113 @@ namespace embree
   template<int N>
   void BVHN<N>::set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives)
   {
+    clearNumaReplicas();
     this->root = root;
     this->bounds = bounds;
     this->numPrimitives = numPrimitives;
   }
 
+  template<int N>
+  void BVHN<N>::replicateNumaNodes()
+  {
+    clearNumaReplicas();
+
+    const size_t levels = device->numa_replicate_levels;
+    const size_t numNodes = getNumberOfNumaNodes();
+    if (levels == 0 || numNodes <= 1 || msmblur || !root.isAlignedNode())
+      return;
+
+    /* each replica gets allocated separately such that its pages get bound to its NUMA node */
+    const size_t numAlignedNodes = countNumaReplicaNodes(root,levels);
+    const size_t bytes = numAlignedNodes*sizeof(AlignedNode);
+    for (size_t i=0; i<numNodes; i++)
+    {
+      device->memoryMonitor(bytes,false);
+      AlignedNode* nodes = (AlignedNode*) os_malloc(bytes);
+      os_bind_numa(nodes,bytes,i);
+      size_t next = 0;
+      numaRoots.push_back(replicateNumaNodesRecursion(root,levels,nodes,next));
+      numaReplicas.push_back(std::make_pair((void*)nodes,bytes));
+      assert(next == numAlignedNodes);
+    }
+  }
+
+  template<int N>
+  size_t BVHN<N>::countNumaReplicaNodes(NodeRef node, size_t depth)
+  {
+    if (depth == 0 || !node.isAlignedNode()) return 0;
+    size_t num = 1;
+    for (size_t c=0; c<N; c++)
+      num += countNumaReplicaNodes(node.alignedNode()->child(c),depth-1);
+    return num;
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::replicateNumaNodesRecursion(NodeRef node, size_t depth, AlignedNode* nodes, size_t& next)
+  {
+    if (depth == 0 || !node.isAlignedNode()) return node;
+    AlignedNode* newnode = &nodes[next++];
+    *newnode = *node.alignedNode();
+    for (size_t c=0; c<N; c++)
+      newnode->child(c) = replicateNumaNodesRecursion(newnode->child(c),depth-1,nodes,next);
+    return encodeNode(newnode);
+  }
+
+  template<int N>
+  void BVHN<N>::clearNumaReplicas()
+  {
+    numaRoots.clear();
+    for (size_t i=0; i<numaReplicas.size(); i++) {
+      os_free(numaReplicas[i].first,numaReplicas[i].second);
+      device->memoryMonitor(-ssize_t(numaReplicas[i].second),true);
+    }
+    numaReplicas.clear();
+  }
+
   template<int N>
   void BVHN<N>::printStatistics()
   {
     std::cout << BVHNStatistics<N>(this).str();
   }	
 
+  template<int N>
+  void BVHN<N>::addMemoryStatistics(RTCMemoryStatistics& stats)
+  {
+    BVHNStatistics<N> stat(this);
+    stats.innerNodes += stat.bytesUsed()-stat.bytesLeaves();
+    stats.leaves += stat.bytesLeaves();
+    for (size_t i=0; i<numaReplicas.size(); i++)
+      stats.innerNodes += numaReplicas[i].second;
+    addAllocatorStatistics(stats);
+
+    /* the nodes of the objects of a two level BVH are reached through
+     * the toplevel hierarchy, instanced objects are hidden behind
+     * transform nodes */
+    const bool instanced = stat.numTransformNodes() != 0;
+    for (size_t i=0; i<objects.size(); i++) {
+      if (!objects[i]) continue;
+      if (instanced) objects[i]->addMemoryStatistics(stats);
+      else           objects[i]->addAllocatorStatistics(stats);
+    }
+  }
+
+  template<int N>
+  void BVHN<N>::addAllocatorStatistics(RTCMemoryStatistics& stats)
+  {
+    stats.primRefs += buildMonitor.peak;
+    stats.wasted += alloc.getWastedBytes();
+    stats.free += alloc.getFreeBytes();
+  }
+
+  template<int N>
+  void BVHN<N>::BuildMemoryMonitor::memoryMonitor(ssize_t bytes, bool post)
+  {
+    device->memoryMonitor(bytes,post);
+    const ssize_t cur = this->bytes.fetch_add(bytes)+bytes;
+    ssize_t old = peak.load();
+    while (cur > old && !peak.compare_exchange_weak(old,cur));
+  }
+
   template<int N>
   void BVHN<N>::clearBarrier(NodeRef& node)
   {
@@ -127,6 +224,8 @@ namespace embree
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
+    buildMonitor.reset();
+
     if (builderName == "") 
       return inf;
 
@@ -143,6 +242,8 @@ namespace embree
   {
     if (t0 == double(inf))
       return;
+
+    replicateNumaNodes();
     
     double dt = 0.0;
     if (device->benchmark || device->verbosity(1)) 
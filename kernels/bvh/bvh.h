@@ -35,6 +35,7 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_TRANSFORM_NODE = 0x10000,
     BVH_FLAG_QUANTIZED_NODE = 0x100000,
+    BVH_FLAG_HALF_NODE = 0x1000000,
 
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
@@ -46,7 +47,8 @@ namespace embree
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_TN_AN1 = BVH_FLAG_TRANSFORM_NODE | BVH_FLAG_ALIGNED_NODE,
     BVH_TN_AN1_AN2 = BVH_FLAG_TRANSFORM_NODE | BVH_FLAG_ALIGNED_NODE | BVH_FLAG_ALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_HN1 = BVH_FLAG_HALF_NODE
   };
 
   /*! Multi BVH with N children. Each node stores the bounding box of
@@ -65,6 +67,7 @@ namespace embree
     struct UnalignedNodeMB;
     struct TransformNode;
     struct QuantizedNode;
+    struct HalfNode;
 
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -84,6 +87,7 @@ namespace embree
     static const size_t tyUnalignedNodeMB = 3;
     static const size_t tyTransformNode = 4;
     static const size_t tyQuantizedNode = 5;
+    static const size_t tyHalfNode = 6;
     static const size_t tyLeaf = 8;
 
     /*! Empty node */
@@ -173,6 +177,33 @@ namespace embree
       BVHN* bvh;
     };
 
+    /*! Builder interface to create Node */
+    struct CreateHalfNode
+    {
+      __forceinline CreateHalfNode (BVHN* bvh) : bvh(bvh) {}
+
+      template<typename BuildRecord>
+      __forceinline AlignedNode* operator() (const BuildRecord& current, BuildRecord* children, const size_t n, FastAllocator::ThreadLocal2* alloc)
+      {
+        __aligned(64) AlignedNode node;
+        node.clear();
+        for (size_t i=0; i<n; i++) {
+          node.set(i,children[i].bounds());
+        }
+        HalfNode *hnode = (HalfNode*) alloc->alloc0->malloc(sizeof(HalfNode), byteNodeAlignment);
+        hnode->init(node);
+
+        for (size_t i=0; i<n; i++) {
+          children[i].parent = (size_t*)&hnode->child(i);
+        };
+
+        *current.parent = (size_t)hnode | tyHalfNode;
+        return NULL;
+      }
+
+      BVHN* bvh;
+    };
+
     struct NoRotate
     {
       __forceinline size_t operator() (AlignedNode* node, const size_t* counts, const size_t n) {
@@ -343,6 +374,9 @@ namespace embree
       /*! checks if this is a quantized node */
       __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
 
+      /*! checks if this is a node with half precision bounds */
+      __forceinline int isHalfNode() const { return (ptr & (size_t)align_mask) == tyHalfNode; }
+
       /*! returns base node pointer */
       __forceinline BaseNode* baseNode(int types)
       {
@@ -389,6 +423,10 @@ namespace embree
       __forceinline       QuantizedNode* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode*)(ptr & ~(size_t)align_mask); }
       __forceinline const QuantizedNode* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode*)(ptr & ~(size_t)align_mask); }
 
+      /*! returns half precision node pointer */
+      __forceinline       HalfNode* halfNode()       { assert(isHalfNode()); return (      HalfNode*)(ptr & ~(size_t)align_mask); }
+      __forceinline const HalfNode* halfNode() const { assert(isHalfNode()); return (const HalfNode*)(ptr & ~(size_t)align_mask); }
+
       /*! returns leaf pointer */
       __forceinline char* leaf(size_t& num) const {
         assert(isLeaf());
@@ -878,6 +916,10 @@ namespace embree
         i_floor_lower  = select(m_lower_correction,i_floor_lower-1,i_floor_lower);
         i_ceil_upper   = select(m_upper_correction,i_ceil_upper +1,i_ceil_upper);
 
+        /* the correction may leave the 8 bit range, minF and minF+255*scale_diff are conservative there */
+        i_floor_lower  = max(i_floor_lower,vint<N>(MIN_QUAN_8BIT));
+        i_ceil_upper   = min(i_ceil_upper ,vint<N>(MAX_QUAN_8BIT));
+
         /* disable invalid lanes */
         i_floor_lower = select(m_valid,i_floor_lower,255);
         i_ceil_upper  = select(m_valid,i_ceil_upper ,0);
@@ -938,6 +980,145 @@ namespace embree
       Vec3f scale;
     };
 
+    /*! BVHN Node with half precision bounds. The bounds are stored as
+     *  IEEE half float offsets to the lower corner of the node, rounded
+     *  outwards such that each child box stays conservative. */
+    struct __aligned(16) HalfNode : public BaseNode
+    {
+      using BaseNode::children;
+
+      static const unsigned short HALF_POS_INF = 0x7c00;
+      static const unsigned short HALF_NEG_INF = 0xfc00;
+      static const unsigned short HALF_MAX     = 0x7bff;
+      static const unsigned short HALF_MIN     = 0x0400; //!< smallest normalized half, denormals are never stored
+
+      /*! Clears the node. */
+      __forceinline void clear() {
+        for (size_t i=0; i<N; i++) lower_x[i] = lower_y[i] = lower_z[i] = HALF_POS_INF;
+        for (size_t i=0; i<N; i++) upper_x[i] = upper_y[i] = upper_z[i] = HALF_NEG_INF;
+        start = Vec3f(zero);
+        BaseNode::clear();
+      }
+
+      /*! converts a half float to float, exact for all non-NaN values */
+      static __forceinline float half_to_float(const unsigned short h)
+      {
+        const unsigned int e = (h >> 10) & 0x1f, m = h & 0x3ff;
+        const float sign = (h & 0x8000) ? -1.0f : 1.0f;
+        if (e == 0x1f) return sign*float(pos_inf);
+        if (e == 0) return sign*float(m)*(1.0f/16777216.0f);
+        return sign*cast_i2f(int(((e+112) << 23) | (m << 13)));
+      }
+
+      /*! largest half float with magnitude not above a positive float */
+      static __forceinline unsigned short half_trunc(const float a)
+      {
+        if (a >= 65504.0f) return HALF_MAX;
+        if (a < 6.103515625e-05f) return 0;
+        const unsigned int i = (unsigned int) cast_f2i(a);
+        return (unsigned short) (((((i >> 23) & 0xff) - 112) << 10) | ((i >> 13) & 0x3ff));
+      }
+
+      /*! smallest half float with magnitude not below a positive float */
+      static __forceinline unsigned short half_ceil(const float a)
+      {
+        if (a == 0.0f) return 0;
+        if (a > 65504.0f) return HALF_POS_INF;
+        if (a <= 6.103515625e-05f) return HALF_MIN;
+        unsigned short h = half_trunc(a);
+        if (half_to_float(h) < a) h++;
+        return h;
+      }
+
+      /*! next smaller and next larger half float, skipping denormals */
+      static __forceinline unsigned short half_pred(const unsigned short h)
+      {
+        if (h == 0 || h == 0x8000) return 0x8000 | HALF_MIN;
+        if (h == HALF_MIN) return 0;
+        if (h & 0x8000) return h == HALF_NEG_INF ? h : h+1;
+        return h-1;
+      }
+      static __forceinline unsigned short half_succ(const unsigned short h)
+      {
+        if (h == 0 || h == 0x8000) return HALF_MIN;
+        if (h == (0x8000 | HALF_MIN)) return 0;
+        if (h & 0x8000) return h-1;
+        return h == HALF_POS_INF ? h : h+1;
+      }
+
+      /*! rounds downwards and upwards to half precision */
+      static __forceinline unsigned short float_to_half_down(const float f) { return f >= 0.0f ? half_trunc(f) : (0x8000 | half_ceil(-f)); }
+      static __forceinline unsigned short float_to_half_up  (const float f) { return f >= 0.0f ? half_ceil(f) : (0x8000 | half_trunc(-f)); }
+
+      static __forceinline void init_dim(const vfloat<N>& lower, const vfloat<N>& upper,
+                                         unsigned short lower_half[N], unsigned short upper_half[N],
+                                         float& start)
+      {
+        const vbool<N> m_valid = lower != vfloat<N>(pos_inf);
+        start = reduce_min(select(m_valid,lower,vfloat<N>(zero)));
+        for (size_t i=0; i<N; i++)
+        {
+          if (!m_valid[i]) {
+            lower_half[i] = HALF_POS_INF;
+            upper_half[i] = HALF_NEG_INF;
+            continue;
+          }
+
+          /* the offsets are added to start in single precision during traversal, correct for that rounding too */
+          unsigned short l = float_to_half_down(lower[i]-start);
+          while (start + half_to_float(l) > lower[i]) l = half_pred(l);
+          unsigned short u = float_to_half_up(upper[i]-start);
+          while (start + half_to_float(u) < upper[i]) u = half_succ(u);
+          lower_half[i] = l;
+          upper_half[i] = u;
+        }
+      }
+
+      __forceinline void init(AlignedNode& node)
+      {
+        for (size_t i=0;i<N;i++) children[i] = emptyNode;
+        init_dim(node.lower_x,node.upper_x,lower_x,upper_x,start.x);
+        init_dim(node.lower_y,node.upper_y,lower_y,upper_y,start.y);
+        init_dim(node.lower_z,node.upper_z,lower_z,upper_z,start.z);
+      }
+
+      /*! Returns bounds of specified child. */
+      __forceinline BBox3fa bounds(size_t i) const
+      {
+        assert(i < N);
+        const Vec3fa lower(start.x + half_to_float(lower_x[i]),
+                           start.y + half_to_float(lower_y[i]),
+                           start.z + half_to_float(lower_z[i]));
+        const Vec3fa upper(start.x + half_to_float(upper_x[i]),
+                           start.y + half_to_float(upper_y[i]),
+                           start.z + half_to_float(upper_z[i]));
+        return BBox3fa(lower,upper);
+      }
+
+      /*! Returns extent of bounds of specified child. */
+      __forceinline Vec3fa extend(size_t i) const {
+        return bounds(i).size();
+      }
+
+      /*! converts the N half floats starting at the given byte offset */
+      template <int M>
+      __forceinline vfloat<M> dequantize(const size_t offset) const { return convert_from_hf16((const unsigned short*)((const char*)all_planes+offset)); }
+
+      union {
+        struct {
+          unsigned short lower_x[N]; //!< half precision X dimension of lower bounds of all N children, relative to start
+          unsigned short upper_x[N]; //!< half precision X dimension of upper bounds of all N children, relative to start
+          unsigned short lower_y[N]; //!< half precision Y dimension of lower bounds of all N children, relative to start
+          unsigned short upper_y[N]; //!< half precision Y dimension of upper bounds of all N children, relative to start
+          unsigned short lower_z[N]; //!< half precision Z dimension of lower bounds of all N children, relative to start
+          unsigned short upper_z[N]; //!< half precision Z dimension of upper bounds of all N children, relative to start
+        };
+        unsigned short all_planes[6*N];
+      };
+
+      Vec3f start;
+    };
+
 
     /*! swap the children of two nodes */
     __forceinline static void swap(AlignedNode* a, size_t i, AlignedNode* b, size_t j)
@@ -1009,6 +1190,14 @@ namespace embree
     /*! prints statistics about the BVH */
     void printStatistics();
 
+    /*! returns the name of the stored primitive type */
+    const char* getName() const {
+      return primTy.name.c_str();
+    }
+
+    /*! adds the memory consumption of the BVH and its objects to the statistics */
+    void addMemoryStatistics(RTCMemoryStatistics& stats);
+
     /*! Clears the barrier bits of a subtree. */
     void clearBarrier(NodeRef& node);
 
@@ -1027,6 +1216,42 @@ namespace embree
     /*! called by all builders after build ended */
     void postBuild(double t0);
 
+    /*! replicates the top levels of the BVH for each NUMA node, has to get called again when nodes get modified */
+    void replicateNumaNodes();
+
+    /*! frees the replicated top levels */
+    void clearNumaReplicas();
+
+  private:
+    NodeRef replicateNumaNodesRecursion(NodeRef node, size_t depth, AlignedNode* nodes, size_t& next);
+    size_t countNumaReplicaNodes(NodeRef node, size_t depth);
+    void addAllocatorStatistics(RTCMemoryStatistics& stats);
+
+  public:
+
+    /*! Forwards allocations of temporary build data to the device
+     *  memory monitor and records the peak amount of such data since
+     *  the last build started. */
+    struct BuildMemoryMonitor : public MemoryMonitorInterface
+    {
+      BuildMemoryMonitor (Device* device)
+        : device(device), bytes(0), peak(0) {}
+
+      void memoryMonitor(ssize_t bytes, bool post);
+
+      /*! restarts the peak recording at the currently allocated bytes */
+      void reset() {
+        peak = bytes.load();
+      }
+
+    public:
+      Device* device;
+      std::atomic<ssize_t> bytes;        //!< currently allocated temporary bytes
+      std::atomic<ssize_t> peak;         //!< peak of allocated temporary bytes
+    };
+
+  public:
+
     /*! allocator class */
     struct Allocator {
       BVHN* bvh;
@@ -1047,9 +1272,10 @@ namespace embree
     }
 
 
-    /*! return the true root */
+    /*! return the true root, or the replica of the top levels that is local to the NUMA node of the calling thread */
     __forceinline NodeRef getRoot(const RayPrecalculations& pre) const {
-      return root;
+      if (likely(numaRoots.empty())) return root;
+      return numaRoots[getNumaNode() % numaRoots.size()];
     }
 
     __forceinline NodeRef getRoot(const RayPrecalculationsMB& pre) const {
@@ -1059,7 +1285,8 @@ namespace embree
 
     template<int K>
     __forceinline NodeRef getRoot(const RayKPrecalculations<K>& pre, size_t k) const {
-      return root;
+      if (likely(numaRoots.empty())) return root;
+      return numaRoots[getNumaNode() % numaRoots.size()];
     }
 
     template<int K>
@@ -1136,6 +1363,9 @@ namespace embree
     bool msmblur;                      //!< when true root points to array of roots for MSMBlur mode
     unsigned numTimeSteps;             //!< number of time steps
     FastAllocator alloc;               //!< allocator used to allocate nodes
+    std::vector<NodeRef> numaRoots;    //!< roots of the top levels replicated per NUMA node
+    std::vector<std::pair<void*,size_t>> numaReplicas; //!< memory of the replicated top levels
+    BuildMemoryMonitor buildMonitor;   //!< monitor for the temporary arrays of the builders
 
     /*! statistics data */
   public:
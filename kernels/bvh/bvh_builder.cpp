@@ -89,7 +89,7 @@ namespace embree
 
 
     template<int N>
-    void BVHNBuilderQuantized<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost)
+    void BVHNBuilderQuantized<N>::BVHNBuilderV::build(BVH* bvh, BuildProgressMonitor& progress_in, PrimRef* prims, const PrimInfo& pinfo, const size_t blockSize, const size_t minLeafSize, const size_t maxLeafSize, const float travCost, const float intCost, const bool halfNodes)
     {
       //bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
       auto progressFunc = [&] (size_t dn) { 
@@ -101,15 +101,20 @@ namespace embree
       };
             
       NodeRef root = 0;
-      BVHBuilderBinnedSAH::build_reduce<NodeRef>
-        (root,typename BVH::CreateAlloc(bvh),size_t(0),typename BVH::CreateQuantizedNode(bvh),dummy<N>,createLeafFunc,progressFunc,
-         prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
-
-      NodeRef new_root = (size_t)root | BVH::tyQuantizedNode;
+      if (halfNodes)
+        BVHBuilderBinnedSAH::build_reduce<NodeRef>
+          (root,typename BVH::CreateAlloc(bvh),size_t(0),typename BVH::CreateHalfNode(bvh),dummy<N>,createLeafFunc,progressFunc,
+           prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+      else
+        BVHBuilderBinnedSAH::build_reduce<NodeRef>
+          (root,typename BVH::CreateAlloc(bvh),size_t(0),typename BVH::CreateQuantizedNode(bvh),dummy<N>,createLeafFunc,progressFunc,
+           prims,pinfo,N,BVH::maxBuildDepthLeaf,blockSize,minLeafSize,maxLeafSize,travCost,intCost);
+
+      /* CreateQuantizedNode and CreateHalfNode already encode inner nodes, the root may also be a single leaf */
       // todo: COPY LAYOUT FOR LARGE NODES !!!
       //bvh->layoutLargeNodes(pinfo.size()*0.005f);
-      assert(new_root.isQuantizedNode());
-      bvh->set(new_root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+      assert(root.isQuantizedNode() || root.isHalfNode() || root.isLeaf());
+      bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
     }
 
     template<int N>
@@ -40,7 +40,7 @@ namespace embree
       mvector<BezierPrim> prims;
 
       BVHNHairBuilderSAH (BVH* bvh, Scene* scene)
-        : bvh(bvh), scene(scene), prims(scene->device) {}
+        : bvh(bvh), scene(scene), prims(&bvh->buildMonitor) {}
       
       void build(size_t, size_t) 
       {
@@ -141,7 +141,7 @@ namespace embree
       mvector<BezierPrim> prims;
 
       BVHNHairMBBuilderSAH (BVH* bvh, Scene* scene)
-        : bvh(bvh), scene(scene), prims(scene->device) {}
+        : bvh(bvh), scene(scene), prims(&bvh->buildMonitor) {}
       
       void build(size_t, size_t) 
       {
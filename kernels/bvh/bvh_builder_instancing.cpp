@@ -36,7 +36,7 @@ namespace embree
 
     template<int N>
     BVHNBuilderInstancing<N>::BVHNBuilderInstancing (BVH* bvh, Scene* scene)
-      : bvh(bvh), objects(bvh->objects), scene(scene), refs(scene->device), prims(scene->device), nextRef(0) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), refs(&bvh->buildMonitor), prims(&bvh->buildMonitor), nextRef(0) {}
     
     template<int N>
     BVHNBuilderInstancing<N>::~BVHNBuilderInstancing ()
@@ -397,7 +397,7 @@ namespace embree
     public:
       
       BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, const size_t minLeafSize, const size_t maxLeafSize)
-        : bvh(bvh), mesh(mesh), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), numPrimitives(0), morton(bvh->device) {}
+        : bvh(bvh), mesh(mesh), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), numPrimitives(0), morton(&bvh->buildMonitor) {}
       
       /*! Destruction */
       ~BVHNMeshBuilderMorton () {
@@ -407,13 +407,11 @@ namespace embree
       /* build function */
       void build(size_t threadIndex, size_t threadCount) 
       {
-        /* We have to clear the allocator to guarantee that we can
-         * temporarily use the first allocation block for sorting the
-         * morton codes. */
-
-        const size_t numNewPrimitives = mesh->size();
-        if (numNewPrimitives != numPrimitives) bvh->alloc.clear();
-        numPrimitives = numNewPrimitives;
+        /* The blocks of the previous build get reused even if the
+         * number of primitives changed, specialAlloc creates a new
+         * first block in case the retained one is too small for
+         * sorting the morton codes. */
+        numPrimitives = mesh->size();
         
         /* skip build for empty scene */
         if (numPrimitives == 0) {
@@ -42,7 +42,6 @@ namespace embree
 {
   namespace isa
   {
-    MAYBE_UNUSED static const float travCost = 1.0f;
     MAYBE_UNUSED static const float defaultPresplitFactor = 1.2f;
 
     typedef FastAllocator::ThreadLocal2 Allocator;
@@ -145,23 +144,25 @@ namespace embree
     struct BVHNBuilderSAH : public Builder
     {
       typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
       BVH* bvh;
       Scene* scene;
       Mesh* mesh;
       mvector<PrimRef> prims;
       const size_t sahBlockSize;
+      const float travCost;
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const float presplitFactor;
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
           presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
 
 
       BVHNBuilderSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
           presplitFactor((mode & MODE_HIGH_QUALITY ) ? defaultPresplitFactor : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -178,6 +179,16 @@ namespace embree
         
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
+        /* stream build in chunks if the primref array exceeds the build memory limit */
+        const size_t memoryLimit = bvh->device->build_memory_limit;
+        if (scene && memoryLimit && numPrimitives*sizeof(PrimRef) > memoryLimit) 
+        {
+          buildStreaming(memoryLimit);
+          bvh->cleanup();
+          bvh->postBuild(t0);
+          return;
+        }
+
 #if PROFILE
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
@@ -220,6 +231,73 @@ namespace embree
         bvh->postBuild(t0);
       }
 
+      /*! Builds one sub-BVH for each spatially coherent chunk of
+       *  primitives and a top level BVH over the roots of all
+       *  chunks. The primitive references are spilled to a temporary
+       *  file, such that only the chunk currently built has to be kept
+       *  in memory. */
+      void buildStreaming(const size_t memoryLimit)
+      {
+        PrimRef* spill = nullptr;
+        std::vector<range<size_t>> chunks;
+        const size_t maxChunkSize = max(memoryLimit/sizeof(PrimRef),size_t(1));
+        const PrimInfo pinfo = createPrimRefChunks<Mesh>(scene,spill,chunks,maxChunkSize,bvh->scene->progressInterface);
+        if (pinfo.size() == 0) {
+          bvh->clear();
+          return;
+        }
+
+        try
+        {
+          /* build sub-BVH of each chunk */
+          bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
+          std::vector<NodeRef> roots(chunks.size());
+          mvector<PrimRef> refs(&bvh->buildMonitor,chunks.size());
+          size_t peakBytes = 0;
+          for (size_t i=0; i<chunks.size(); i++)
+          {
+            PrimRef* chunk = spill+chunks[i].begin();
+            const size_t bytes = chunks[i].size()*sizeof(PrimRef);
+            scene->device->memoryMonitor(bytes,false);
+            peakBytes = max(peakBytes,bytes);
+
+            PrimInfo cinfo = parallel_reduce(size_t(0),chunks[i].size(),size_t(1024),PrimInfo(empty), [&](const range<size_t>& r) -> PrimInfo {
+                PrimInfo cinfo(empty);
+                for (size_t j=r.begin(); j<r.end(); j++) cinfo.add(chunk[j].bounds(),chunk[j].center2());
+                return cinfo;
+              }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+            cinfo.begin = 0; cinfo.end = chunks[i].size();
+
+            BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,chunk),bvh->scene->progressInterface,chunk,cinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            roots[i] = bvh->root;
+            refs[i] = PrimRef(cinfo.geomBounds,i);
+
+            /* the references of this chunk are no longer needed */
+            os_discard(chunk,bytes);
+            scene->device->memoryMonitor(-ssize_t(bytes),true);
+          }
+
+          /* build top level BVH over all chunks */
+          PrimInfo tinfo(empty);
+          for (size_t i=0; i<chunks.size(); i++) tinfo.add(refs[i].bounds(),refs[i].center2());
+          BVHNBuilder<N>::build(bvh,[&] (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) -> size_t {
+              assert(current.prims.size() == 1);
+              *current.parent = roots[refs[current.prims.begin()].ID()];
+              return 1;
+            },bvh->scene->progressInterface,refs.data(),tinfo,1,1,1,travCost,intCost);
+          bvh->set(bvh->root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+
+          if (scene->device->verbosity(2))
+            std::cout << "streamed build of " << pinfo.size() << " primitives in " << chunks.size() << " chunks, peak primref memory " 
+                      << 1E-6*double(peakBytes) << " MB, spilled " << 1E-6*double(pinfo.size()*sizeof(PrimRef)) << " MB" << std::endl;
+        }
+        catch (...) {
+          os_unmap_tmpfile(spill,pinfo.size()*sizeof(PrimRef));
+          throw;
+        }
+        os_unmap_tmpfile(spill,pinfo.size()*sizeof(PrimRef));
+      }
+
       void clear() {
         prims.clear();
       }
@@ -239,18 +317,20 @@ namespace embree
       Mesh* mesh;
       mvector<PrimRef> prims;
       const size_t sahBlockSize;
+      const float travCost;
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const float presplitFactor;
+      const bool halfNodes;
 
       BVHNBuilderSAHQuantized (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f), halfNodes(mode & MODE_HALF_NODES) {}
 
       BVHNBuilderSAHQuantized (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
+          presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f), halfNodes(mode & MODE_HALF_NODES) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -264,7 +344,7 @@ namespace embree
           return;
         }
 
-        double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::QBVH" + toString(N) + "BuilderSAH");
+        double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) + std::string(halfNodes ? "::HBVH" : "::QBVH") + toString(N) + "BuilderSAH");
 
 #if PROFILE
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
@@ -282,7 +362,7 @@ namespace embree
         
             /* call BVH builder */
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-            BVHNBuilderQuantized<N>::build(bvh,CreateLeafQuantized<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            BVHNBuilderQuantized<N>::build(bvh,CreateLeafQuantized<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost,halfNodes);
 
 #if PROFILE
           }); 
@@ -341,13 +421,14 @@ namespace embree
       Scene* scene;
       mvector<PrimRef> prims; 
       const size_t sahBlockSize;
+      const float travCost;
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
 
       BVHNBuilderMSMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
-        : bvh(bvh), scene(scene), prims(scene->device), 
-          sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
+        : bvh(bvh), scene(scene), prims(&bvh->buildMonitor), 
+          sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)) {}
 
       void build(size_t, size_t) 
       {
@@ -430,17 +511,18 @@ namespace embree
       Mesh* mesh;
       mvector<PrimRef> prims0;
       const size_t sahBlockSize;
+      const float travCost;
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const float splitFactor;
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims0(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
           splitFactor(scene->device->max_spatial_split_replications) {}
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims0(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
           splitFactor(scene->device->max_spatial_split_replications) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -577,18 +659,19 @@ namespace embree
       Mesh* mesh;
       mvector<PrimRef> prims;
       const size_t sahBlockSize;
+      const float travCost;
       const float intCost;
       const size_t minLeafSize;
       const size_t maxLeafSize;
       const float presplitFactor;
 
       BVHNBuilderSweepSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
           presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
 
 
       BVHNBuilderSweepSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(&bvh->buildMonitor), sahBlockSize(sahBlockSize), travCost(bvh->device->sah_trav_cost), intCost(intCost*bvh->device->sah_int_cost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,bvh->device->sah_max_leaf_size,Primitive::max_size()*BVH::maxLeafBlocks)),
           presplitFactor((mode & MODE_HIGH_QUALITY ) ? defaultPresplitFactor : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -682,6 +765,7 @@ namespace embree
 
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4HalfTriangle4iSceneBuilderSAH      (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode | MODE_HALF_NODES); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
@@ -710,6 +794,7 @@ namespace embree
     Builder* BVH4Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,scene ,4,1.0f,4,inf); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4HalfQuad4iSceneBuilderSAH          (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode | MODE_HALF_NODES); }
     Builder* BVH4Quad4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4v,QuadSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 
 #if defined(__AVX__)
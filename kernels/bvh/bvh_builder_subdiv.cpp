@@ -51,7 +51,7 @@ namespace embree
       ParallelForForPrefixSumState<PrimInfo> pstate;
       
       BVHNSubdivPatch1EagerBuilderBinnedSAHClass (BVH* bvh, Scene* scene)
-        : bvh(bvh), scene(scene), prims(scene->device) {}
+        : bvh(bvh), scene(scene), prims(&bvh->buildMonitor) {}
 
 #define SUBGRID 9
 
@@ -211,7 +211,7 @@ namespace embree
       bool cached;
 
       BVHNSubdivPatch1CachedBuilderBinnedSAHClass (BVH* bvh, Scene* scene, bool cached)
-        : bvh(bvh), refitter(nullptr), scene(scene), numTimeSteps(0), prims(scene->device), bounds(scene->device), numSubdivEnableDisableEvents(0), cached(cached) {}
+        : bvh(bvh), refitter(nullptr), scene(scene), numTimeSteps(0), prims(&bvh->buildMonitor), bounds(scene->device), numSubdivEnableDisableEvents(0), cached(cached) {}
       
       virtual const BBox3fa leafBounds (NodeRef& ref) const
       {
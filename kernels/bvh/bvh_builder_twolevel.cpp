@@ -24,6 +24,7 @@
 #define PROFILE 0
 #define MAX_OPEN_SIZE 10000
 #define PROFILE_ITERATIONS 200
+#define SINGLE_THREADED_REFIT_THRESHOLD 1024
 
 namespace embree
 {
@@ -31,7 +32,8 @@ namespace embree
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device), prims(scene->device) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(&bvh->buildMonitor), prims(&bvh->buildMonitor),
+        refitNodes(scene->device), refitRoot(-1), buildSAH(0.0) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel ()
@@ -54,13 +56,12 @@ namespace embree
           });
       }
 
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives<Mesh,false>();
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
         prims.resize(0);
+        refitRoot = -1;
         bvh->set(BVH::emptyNode,empty,0);
         return;
       }
@@ -120,10 +121,30 @@ namespace embree
           
           /* create build primitive */
           if (!object->getBounds().empty())
-            refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root);
+            refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root,unsigned(objectID));
         }
       });
 
+      /* refit toplevel hierarchy if only the objects changed, e.g. when instances got moved */
+      if (refitable(nextRef))
+      {
+        double sah = 0.0;
+        const BBox3fa bounds = refit(refitRoot,sah);
+        sah /= halfArea(bounds);
+        if (sah <= bvh->device->toplevel_refit_threshold*buildSAH)
+        {
+          if (bvh->device->verbosity(2))
+            std::cout << "refitted toplevel, SAH = " << sah << " (" << buildSAH << " after build)" << std::endl;
+          bvh->set(bvh->root,LBBox3fa(bounds),numPrimitives);
+          bvh->postBuild(t0);
+          return;
+        }
+      }
+
+      /* reset memory allocator */
+      bvh->alloc.reset();
+      refitRoot = -1;
+
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
@@ -133,6 +154,7 @@ namespace embree
       {
         /* open all large nodes */
         refs.resize(nextRef);
+        const size_t numObjects = refs.size();
         open_sequential(numPrimitives); 
         /* compute PrimRefs */
         prims.resize(refs.size());
@@ -147,7 +169,7 @@ namespace embree
               PrimInfo pinfo(empty);
               for (size_t i=r.begin(); i<r.end(); i++) {
                 pinfo.add(refs[i].bounds());
-                prims[i] = PrimRef(refs[i].bounds(),(size_t)refs[i].node);
+                prims[i] = PrimRef(refs[i].bounds(),i);
               }
               return pinfo;
             }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
@@ -160,10 +182,14 @@ namespace embree
           else
           {
             NodeRef root;
+            refitNodes.resize(refs.size());
+            nextRefitNode.store(0);
 
-            BVHBuilderBinnedSAH::build<NodeRef>
+            /* the reduction links the refit nodes such that the hierarchy can get refitted later on */
+            const int rootID = BVHBuilderBinnedSAH::build_reduce<NodeRef>
               (root,
                [&] { return bvh->alloc.threadLocal2(); },
+               int(-1),
                [&] (const isa::BVHBuilderBinnedSAH::BuildRecord& current, BVHBuilderBinnedSAH::BuildRecord* children, const size_t n, FastAllocator::ThreadLocal2* alloc) -> int
               {
                 AlignedNode* node = (AlignedNode*) alloc->alloc0->malloc(sizeof(AlignedNode)); node->clear();
@@ -172,18 +198,41 @@ namespace embree
                   children[i].parent = (size_t*)&node->child(i);
                 }
                 *current.parent = bvh->encodeNode(node);
-                return 0;
+                const int nodeID = nextRefitNode++;
+                refitNodes[nodeID].node = node;
+                refitNodes[nodeID].size = current.size();
+                return nodeID;
+              },
+               [&] (int nodeID, int* children, size_t n) -> int
+              {
+                RefitNode& refitNode = refitNodes[nodeID];
+                for (size_t i=0; i<N; i++) 
+                  refitNode.children[i] = i < n ? children[i] : -1;
+                return nodeID;
               },
                [&] (const BVHBuilderBinnedSAH::BuildRecord& current, FastAllocator::ThreadLocal2* alloc) -> int
               {
                 assert(current.prims.size() == 1);
-                *current.parent = (NodeRef) prims[current.prims.begin()].ID();
-                return 1;
+                const BuildRef& ref = refs[prims[current.prims.begin()].ID()];
+                *current.parent = ref.node;
+                return -int(ref.objectID)-2;
               },
                [&] (size_t dn) { bvh->scene->progressMonitor(0); },
                prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,N,1,1,1.0f,1.0f);
 
             bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+
+            /* the hierarchy can only get refitted if no object got opened */
+            if (refs.size() == numObjects && rootID >= 0 && bvh->device->toplevel_refit_threshold > 0.0f)
+            {
+              refitObjects.resize(refs.size());
+              for (size_t i=0; i<refs.size(); i++)
+                refitObjects[i] = refs[i].objectID;
+              refitRoot = rootID;
+              buildSAH = 0.0;
+              refit(refitRoot,buildSAH);
+              buildSAH /= halfArea(pinfo.geomBounds);
+            }
           }
         }
 #if defined(TASKING_TBB) && defined(__AVX512F__) && USE_TASK_ARENA
@@ -217,6 +266,8 @@ namespace embree
 	if (builders[i]) builders[i]->clear();
 
       refs.clear();
+      refitNodes.clear();
+      refitRoot = -1;
     }
 
     template<int N, typename Mesh>
@@ -243,12 +294,13 @@ namespace embree
         std::pop_heap (refs.begin(),refs.end()); 
         NodeRef ref = refs.back().node;
         if (ref.isLeaf()) break;
+        const unsigned objectID = refs.back().objectID;
         refs.pop_back();    
         
         AlignedNode* node = ref.alignedNode();
         for (size_t i=0; i<N; i++) {
           if (node->child(i) == BVH::emptyNode) continue;
-          refs.push_back(BuildRef(node->bounds(i),node->child(i)));
+          refs.push_back(BuildRef(node->bounds(i),node->child(i),objectID));
          
 #if 1
           NodeRef ref_pre = node->child(i);
@@ -260,6 +312,70 @@ namespace embree
       }
     }
 
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::refitable(size_t numObjects)
+    {
+      if (refitRoot < 0 || numObjects != refitObjects.size())
+        return false;
+
+      /* all objects of the last build have to be still present */
+      return parallel_reduce(size_t(0), refitObjects.size(), size_t(1024), true, [&] (const range<size_t>& r) -> bool
+      {
+        for (size_t i=r.begin(); i<r.end(); i++) 
+        {
+          const unsigned objectID = refitObjects[i];
+          Mesh* mesh = scene->getSafe<Mesh>(objectID);
+          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) return false;
+          if (objects[objectID] == nullptr || objects[objectID]->getBounds().empty()) return false;
+        }
+        return true;
+      }, [] (const bool a, const bool b) { return a && b; });
+    }
+
+    template<int N, typename Mesh>
+    BBox3fa BVHNBuilderTwoLevel<N,Mesh>::refit(int nodeID, double& sah)
+    {
+      /* leaves reference the root of some object */
+      if (nodeID < -1) {
+        const BBox3fa bounds = objects[-nodeID-2]->getBounds();
+        sah += halfArea(bounds);
+        return bounds;
+      }
+
+      RefitNode& refitNode = refitNodes[nodeID];
+      BBox3fa bounds[N];
+      double childSAH[N];
+      for (size_t i=0; i<N; i++) {
+        bounds[i] = empty;
+        childSAH[i] = 0.0;
+      }
+
+      auto refitChild = [&] (size_t i) {
+        const int childID = refitNode.children[i];
+        if (childID == -1) return;
+        bounds[i] = refit(childID,childSAH[i]);
+        if (childID < -1) refitNode.node->child(i) = objects[-childID-2]->root;
+      };
+
+      if (refitNode.size > SINGLE_THREADED_REFIT_THRESHOLD) {
+        parallel_for(size_t(0), size_t(N), [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++) refitChild(i);
+          });
+      } else {
+        for (size_t i=0; i<N; i++) refitChild(i);
+      }
+
+      BBox3fa box = empty;
+      for (size_t i=0; i<N; i++) {
+        if (refitNode.children[i] == -1) continue;
+        refitNode.node->set(i,bounds[i]);
+        box.extend(bounds[i]);
+        sah += childSAH[i];
+      }
+      sah += halfArea(box);
+      return box;
+    }
+
 #if defined(EMBREE_GEOMETRY_LINES)    
     Builder* BVH4BuilderTwoLevelLineSegmentsSAH (void* bvh, Scene* scene, const createLineSegmentsAccelTy createMeshAccel) {
       return new BVHNBuilderTwoLevel<4,LineSegments>((BVH4*)bvh,scene,createMeshAccel);
@@ -40,8 +40,8 @@ namespace embree
       public:
         __forceinline BuildRef () {}
 
-        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node)
-          : lower(bounds.lower), upper(bounds.upper), node(node)
+        __forceinline BuildRef (const BBox3fa& bounds, NodeRef node, unsigned objectID)
+          : lower(bounds.lower), upper(bounds.upper), node(node), objectID(objectID)
         {
           if (node.isLeaf())
             lower.w = 0.0f;
@@ -61,6 +61,17 @@ namespace embree
         Vec3fa lower;
         Vec3fa upper;
         NodeRef node;
+        unsigned objectID;
+      };
+
+      /*! Inner node of the toplevel hierarchy as required for refitting. Positive
+       *  children index other refit nodes, negative children encode the ID of the
+       *  object whose root is stored in that slot. */
+      struct RefitNode
+      {
+        AlignedNode* node;
+        int children[N];
+        size_t size;
       };
       
       /*! Constructor. */
@@ -75,6 +86,12 @@ namespace embree
       void clear();
 
       void open_sequential(size_t numPrimitives);
+
+      /*! checks if the toplevel hierarchy can get refitted */
+      bool refitable(size_t numObjects);
+
+      /*! refits the subtree and returns its bounds, accumulates the SAH cost of the subtree */
+      BBox3fa refit(int nodeID, double& sah);
       
     public:
       BVH* bvh;
@@ -88,6 +105,12 @@ namespace embree
       mvector<BuildRef> refs;
       mvector<PrimRef> prims;
       std::atomic<int> nextRef;
+
+      mvector<RefitNode> refitNodes;    //!< inner nodes of the last built toplevel hierarchy
+      std::atomic<int> nextRefitNode;
+      std::vector<unsigned> refitObjects; //!< objects referenced by the toplevel hierarchy
+      int refitRoot;                     //!< root of refit nodes, -1 if hierarchy cannot get refitted
+      double buildSAH;                   //!< SAH cost of the toplevel hierarchy after the last build
     };
   }
 }
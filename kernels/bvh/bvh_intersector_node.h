@@ -629,8 +629,206 @@ namespace embree
       dist = tNear;
       return mask;
     }
-    
+
+#endif
+
+    template<int N, int K>
+      __forceinline vbool<K> intersectNode(const typename BVHN<N>::QuantizedNode* node, size_t i,
+                                           const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                           const vfloat<K>& tnear, const vfloat<K>& tfar, vfloat<K>& dist)
+
+    {
+      /* dequantize the same way as QuantizedNode::init_dim verified the bounds to be conservative */
+      const BBox3fa bounds = node->bounds(i);
+#if defined(__AVX2__)
+      const vfloat<K> lclipMinX = msub(bounds.lower.x,rdir.x,org_rdir.x);
+      const vfloat<K> lclipMinY = msub(bounds.lower.y,rdir.y,org_rdir.y);
+      const vfloat<K> lclipMinZ = msub(bounds.lower.z,rdir.z,org_rdir.z);
+      const vfloat<K> lclipMaxX = msub(bounds.upper.x,rdir.x,org_rdir.x);
+      const vfloat<K> lclipMaxY = msub(bounds.upper.y,rdir.y,org_rdir.y);
+      const vfloat<K> lclipMaxZ = msub(bounds.upper.z,rdir.z,org_rdir.z);
+#else
+      const vfloat<K> lclipMinX = (bounds.lower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (bounds.lower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (bounds.lower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (bounds.upper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (bounds.upper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (bounds.upper.z - org.z) * rdir.z;
 #endif
+      const vfloat<K> lnearP = maxi(maxi(mini(lclipMinX, lclipMaxX), mini(lclipMinY, lclipMaxY)), mini(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = mini(mini(maxi(lclipMinX, lclipMaxX), maxi(lclipMinY, lclipMaxY)), maxi(lclipMinZ, lclipMaxZ));
+      const vbool<K> lhit    = maxi(lnearP,tnear) <= mini(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // robust ray/BVHN::QuantizedNode intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx>
+      __forceinline size_t intersectNodeRobust(const typename BVHN<N>::QuantizedNode* node, const TravRay<N,Nx>& ray,
+                                               const vfloat<Nx>& tnear, const vfloat<Nx>& tfar, vfloat<Nx>& dist)
+    {
+      const vfloat<N> lower_x = node->template dequantize<N>(ray.nearX >> 2) * vfloat<N>(node->scale.x) + vfloat<N>(node->start.x);
+      const vfloat<N> upper_x = node->template dequantize<N>(ray.farX  >> 2) * vfloat<N>(node->scale.x) + vfloat<N>(node->start.x);
+      const vfloat<N> lower_y = node->template dequantize<N>(ray.nearY >> 2) * vfloat<N>(node->scale.y) + vfloat<N>(node->start.y);
+      const vfloat<N> upper_y = node->template dequantize<N>(ray.farY  >> 2) * vfloat<N>(node->scale.y) + vfloat<N>(node->start.y);
+      const vfloat<N> lower_z = node->template dequantize<N>(ray.nearZ >> 2) * vfloat<N>(node->scale.z) + vfloat<N>(node->start.z);
+      const vfloat<N> upper_z = node->template dequantize<N>(ray.farZ  >> 2) * vfloat<N>(node->scale.z) + vfloat<N>(node->start.z);
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+      const float round_down = 1.0f-2.0f*float(ulp);
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const vfloat<N> tNear = max(tNearX,tNearY,tNearZ,tnear);
+      const vfloat<N> tFar  = min(tFarX ,tFarY ,tFarZ ,tfar);
+      const vbool<N> vmask = round_down*tNear <= round_up*tFar;
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
+    template<int N, int K>
+      __forceinline vbool<K> intersectNodeRobust(const typename BVHN<N>::QuantizedNode* node, size_t i,
+                                                 const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                                 const vfloat<K>& tnear, const vfloat<K>& tfar, vfloat<K>& dist)
+    {
+      const BBox3fa bounds = node->bounds(i);
+      const vfloat<K> lclipMinX = (bounds.lower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (bounds.lower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (bounds.lower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (bounds.upper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (bounds.upper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (bounds.upper.z - org.z) * rdir.z;
+      const float round_down = 1.0f-2.0f*float(ulp);
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const vfloat<K> lnearP = max(max(min(lclipMinX, lclipMaxX), min(lclipMinY, lclipMaxY)), min(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = min(min(max(lclipMinX, lclipMaxX), max(lclipMinY, lclipMaxY)), max(lclipMinZ, lclipMaxZ));
+      const vbool<K> lhit   = round_down*max(lnearP,tnear) <= round_up*min(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // fast ray/BVHN::HalfNode intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx>
+      __forceinline size_t intersectNode(const typename BVHN<N>::HalfNode* node, const TravRay<N,Nx>& ray,
+                                         const vfloat<Nx>& tnear, const vfloat<Nx>& tfar, vfloat<Nx>& dist)
+    {
+      /* planes are N halfs wide, thus the float plane offsets are halved */
+      const vfloat<N> lower_x = node->template dequantize<N>(ray.nearX >> 1) + vfloat<N>(node->start.x);
+      const vfloat<N> upper_x = node->template dequantize<N>(ray.farX  >> 1) + vfloat<N>(node->start.x);
+      const vfloat<N> lower_y = node->template dequantize<N>(ray.nearY >> 1) + vfloat<N>(node->start.y);
+      const vfloat<N> upper_y = node->template dequantize<N>(ray.farY  >> 1) + vfloat<N>(node->start.y);
+      const vfloat<N> lower_z = node->template dequantize<N>(ray.nearZ >> 1) + vfloat<N>(node->start.z);
+      const vfloat<N> upper_z = node->template dequantize<N>(ray.farZ  >> 1) + vfloat<N>(node->start.z);
+#if defined (__AVX2__)
+      const vfloat<N> tNearX = msub(lower_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat<N> tNearY = msub(lower_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat<N> tNearZ = msub(lower_z, ray.rdir.z, ray.org_rdir.z);
+      const vfloat<N> tFarX  = msub(upper_x, ray.rdir.x, ray.org_rdir.x);
+      const vfloat<N> tFarY  = msub(upper_y, ray.rdir.y, ray.org_rdir.y);
+      const vfloat<N> tFarZ  = msub(upper_z, ray.rdir.z, ray.org_rdir.z);
+#else
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+#endif
+      const vfloat<N> tNear = max(tNearX,tNearY,tNearZ,tnear);
+      const vfloat<N> tFar  = min(tFarX ,tFarY ,tFarZ ,tfar);
+      const vbool<N> vmask = tNear <= tFar;
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
+    template<int N, int K>
+      __forceinline vbool<K> intersectNode(const typename BVHN<N>::HalfNode* node, size_t i,
+                                           const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                           const vfloat<K>& tnear, const vfloat<K>& tfar, vfloat<K>& dist)
+    {
+      const BBox3fa bounds = node->bounds(i);
+#if defined(__AVX2__)
+      const vfloat<K> lclipMinX = msub(bounds.lower.x,rdir.x,org_rdir.x);
+      const vfloat<K> lclipMinY = msub(bounds.lower.y,rdir.y,org_rdir.y);
+      const vfloat<K> lclipMinZ = msub(bounds.lower.z,rdir.z,org_rdir.z);
+      const vfloat<K> lclipMaxX = msub(bounds.upper.x,rdir.x,org_rdir.x);
+      const vfloat<K> lclipMaxY = msub(bounds.upper.y,rdir.y,org_rdir.y);
+      const vfloat<K> lclipMaxZ = msub(bounds.upper.z,rdir.z,org_rdir.z);
+#else
+      const vfloat<K> lclipMinX = (bounds.lower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (bounds.lower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (bounds.lower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (bounds.upper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (bounds.upper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (bounds.upper.z - org.z) * rdir.z;
+#endif
+      const vfloat<K> lnearP = maxi(maxi(mini(lclipMinX, lclipMaxX), mini(lclipMinY, lclipMaxY)), mini(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = mini(mini(maxi(lclipMinX, lclipMaxX), maxi(lclipMinY, lclipMaxY)), maxi(lclipMinZ, lclipMaxZ));
+      const vbool<K> lhit    = maxi(lnearP,tnear) <= mini(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // robust ray/BVHN::HalfNode intersection
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N, int Nx>
+      __forceinline size_t intersectNodeRobust(const typename BVHN<N>::HalfNode* node, const TravRay<N,Nx>& ray,
+                                               const vfloat<Nx>& tnear, const vfloat<Nx>& tfar, vfloat<Nx>& dist)
+    {
+      const vfloat<N> lower_x = node->template dequantize<N>(ray.nearX >> 1) + vfloat<N>(node->start.x);
+      const vfloat<N> upper_x = node->template dequantize<N>(ray.farX  >> 1) + vfloat<N>(node->start.x);
+      const vfloat<N> lower_y = node->template dequantize<N>(ray.nearY >> 1) + vfloat<N>(node->start.y);
+      const vfloat<N> upper_y = node->template dequantize<N>(ray.farY  >> 1) + vfloat<N>(node->start.y);
+      const vfloat<N> lower_z = node->template dequantize<N>(ray.nearZ >> 1) + vfloat<N>(node->start.z);
+      const vfloat<N> upper_z = node->template dequantize<N>(ray.farZ  >> 1) + vfloat<N>(node->start.z);
+      const vfloat<N> tNearX = (lower_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tNearY = (lower_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tNearZ = (lower_z - ray.org.z) * ray.rdir.z;
+      const vfloat<N> tFarX  = (upper_x - ray.org.x) * ray.rdir.x;
+      const vfloat<N> tFarY  = (upper_y - ray.org.y) * ray.rdir.y;
+      const vfloat<N> tFarZ  = (upper_z - ray.org.z) * ray.rdir.z;
+      const float round_down = 1.0f-2.0f*float(ulp);
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const vfloat<N> tNear = max(tNearX,tNearY,tNearZ,tnear);
+      const vfloat<N> tFar  = min(tFarX ,tFarY ,tFarZ ,tfar);
+      const vbool<N> vmask = round_down*tNear <= round_up*tFar;
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
+    template<int N, int K>
+      __forceinline vbool<K> intersectNodeRobust(const typename BVHN<N>::HalfNode* node, size_t i,
+                                                 const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                                 const vfloat<K>& tnear, const vfloat<K>& tfar, vfloat<K>& dist)
+    {
+      const BBox3fa bounds = node->bounds(i);
+      const vfloat<K> lclipMinX = (bounds.lower.x - org.x) * rdir.x;
+      const vfloat<K> lclipMinY = (bounds.lower.y - org.y) * rdir.y;
+      const vfloat<K> lclipMinZ = (bounds.lower.z - org.z) * rdir.z;
+      const vfloat<K> lclipMaxX = (bounds.upper.x - org.x) * rdir.x;
+      const vfloat<K> lclipMaxY = (bounds.upper.y - org.y) * rdir.y;
+      const vfloat<K> lclipMaxZ = (bounds.upper.z - org.z) * rdir.z;
+      const float round_down = 1.0f-2.0f*float(ulp);
+      const float round_up   = 1.0f+2.0f*float(ulp);
+      const vfloat<K> lnearP = max(max(min(lclipMinX, lclipMaxX), min(lclipMinY, lclipMaxY)), min(lclipMinZ, lclipMaxZ));
+      const vfloat<K> lfarP  = min(min(max(lclipMinX, lclipMaxX), max(lclipMinY, lclipMaxY)), max(lclipMinZ, lclipMaxZ));
+      const vbool<K> lhit   = round_down*max(lnearP,tnear) <= round_up*min(lfarP,tfar);
+      dist = lnearP;
+      return lhit;
+    }
 
     //////////////////////////////////////////////////////////////////////////////////////
     // fast ray/BVHN::UnalignedNode intersection
@@ -799,6 +997,26 @@ namespace embree
       }
     };
 
+    template<int N, int Nx>
+      struct BVHNNodeIntersector1<N,Nx,BVH_HN1,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<Nx>& tnear, const vfloat<Nx>& tfar, const float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        mask = intersectNode<N,Nx>(node.halfNode(),ray,tnear,tfar,dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+      struct BVHNNodeIntersector1<N,Nx,BVH_HN1,true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx>& ray, const vfloat<Nx>& tnear, const vfloat<Nx>& tfar, const float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        mask = intersectNodeRobust<N,Nx>(node.halfNode(),ray,tnear,tfar,dist);
+        return true;
+      }
+    };
+
     /*! Intersects N nodes with K rays */
     template<int N, int K, int types, bool robust>
     struct BVHNNodeIntersectorK;
@@ -846,6 +1064,50 @@ namespace embree
         return true;
       }
     };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_QN1,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNode<N,K>(node.quantizedNode(),i,org,rdir,org_rdir,tnear,tfar,dist);
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_QN1,true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNodeRobust<N,K>(node.quantizedNode(),i,org,rdir,org_rdir,tnear,tfar,dist);
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_HN1,false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNode<N,K>(node.halfNode(),i,org,rdir,org_rdir,tnear,tfar,dist);
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N,K,BVH_HN1,true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const size_t i, const Vec3<vfloat<K>>& org, const Vec3<vfloat<K>>& rdir, const Vec3<vfloat<K>>& org_rdir,
+                                          const vfloat<K>& tnear, const vfloat<K>& tfar, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectNodeRobust<N,K>(node.halfNode(),i,org,rdir,org_rdir,tnear,tfar,dist);
+        return true;
+      }
+    };
   }
 }
 
@@ -303,6 +303,7 @@ namespace embree
       }
       
       refitter->refit();
+      bvh->replicateNumaNodes();
 
       if (bvh->device->verbosity(2)) 
       {
@@ -0,0 +1,423 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "bvh_serializer.h"
+#include "bvh.h"
+#include "../common/scene.h"
+#include "../common/accelinstance.h"
+#include "../../common/algorithms/parallel_for.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace embree
+{
+  /* BVH file layout: a file header, followed by a header and a block
+   * table for each hierarchy, followed by the used memory of all
+   * blocks of that hierarchy, each padded to the maximal alignment. */
+
+  static const char bvhFileMagic[8] = { 'E','M','B','R','E','E','B','V' };
+  static const unsigned int bvhFileVersion = 1;
+  static const size_t bvhFileBlockAlignment = 64;
+
+  struct BVHFileHeader
+  {
+    char magic[8];
+    unsigned int version;
+    unsigned int sizeofNode;         //!< size of an aligned node, to detect incompatible builds
+    unsigned long long geometryHash; //!< hash over all geometry buffers of the scene
+    unsigned long long numAccels;    //!< number of stored hierarchies
+  };
+
+  struct BVHFileAccel
+  {
+    unsigned long long accelIndex;   //!< index of the accel in the scene
+    char primTy[32];                 //!< name of the primitive type
+    unsigned long long sizeofPrim;   //!< size of the primitive type
+    unsigned long long root;         //!< root reference, relative to original block addresses
+    float bounds[12];                //!< linear bounds of the hierarchy
+    unsigned long long numPrimitives;
+    unsigned long long numVertices;
+    unsigned long long numBlocks;    //!< number of stored memory blocks
+    unsigned long long numBytes;     //!< bytes of all stored memory blocks including padding
+  };
+
+  struct BVHFileBlock
+  {
+    unsigned long long base;         //!< original address of the block
+    unsigned long long bytes;        //!< used bytes of the block
+  };
+
+  /*! relocation information of a single memory block */
+  struct BVHBlockRelocation
+  {
+    __forceinline BVHBlockRelocation () {}
+
+    __forceinline BVHBlockRelocation (size_t base, size_t bytes, size_t newBase)
+      : base(base), bytes(bytes), newBase(newBase) {}
+
+    __forceinline bool operator< (const BVHBlockRelocation& other) const {
+      return base < other.base;
+    }
+
+    size_t base;
+    size_t bytes;
+    size_t newBase;
+  };
+
+  /*! only primitive types that do not reference geometry buffers can get stored */
+  static bool isSelfContainedPrimType(const PrimitiveType& primTy)
+  {
+    return
+      primTy.name == "triangle4"  ||
+      primTy.name == "triangle4v" ||
+      primTy.name == "quad4v"     ||
+      primTy.name == "bezier1v";
+  }
+
+  static __forceinline unsigned long long hashWords(unsigned long long h, const char* ptr, size_t bytes)
+  {
+    assert((bytes % 4) == 0);
+    for (size_t i=0; i<bytes; i+=4) {
+      h ^= *(const unsigned int*)(ptr+i);
+      h *= 0x100000001b3ULL;
+    }
+    return h;
+  }
+
+  static __forceinline unsigned long long hashValue(unsigned long long h, size_t value)
+  {
+    const unsigned long long v = value;
+    return hashWords(h,(const char*)&v,sizeof(v));
+  }
+
+  /*! hashes the first elementBytes bytes of each element of a buffer */
+  static unsigned long long hashBuffer(unsigned long long h, const BufferRef& buffer, size_t elementBytes)
+  {
+    h = hashValue(h,buffer.size());
+    for (size_t i=0; i<buffer.size(); i++)
+      h = hashWords(h,buffer.getPtr(i),elementBytes);
+    return h;
+  }
+
+  /*! hashes a geometry, returns false for unsupported geometry types */
+  static bool hashGeometry(const Geometry* geom, unsigned long long& h)
+  {
+    h = 0xcbf29ce484222325ULL;
+    if (geom == nullptr) return true;
+    h = hashValue(h,geom->type);
+    h = hashValue(h,geom->isEnabled());
+    h = hashValue(h,geom->numTimeSteps);
+    h = hashValue(h,geom->mask);
+
+    switch (geom->type)
+    {
+    case Geometry::TRIANGLE_MESH: {
+      const TriangleMesh* mesh = (const TriangleMesh*) geom;
+      h = hashBuffer(h,mesh->triangles,sizeof(TriangleMesh::Triangle));
+      for (size_t t=0; t<mesh->vertices.size(); t++)
+        h = hashBuffer(h,mesh->vertices[t],3*sizeof(float));
+      return true;
+    }
+    case Geometry::QUAD_MESH: {
+      const QuadMesh* mesh = (const QuadMesh*) geom;
+      h = hashBuffer(h,mesh->quads,sizeof(QuadMesh::Quad));
+      for (size_t t=0; t<mesh->vertices.size(); t++)
+        h = hashBuffer(h,mesh->vertices[t],3*sizeof(float));
+      return true;
+    }
+    case Geometry::BEZIER_CURVES: {
+      const BezierCurves* curves = (const BezierCurves*) geom;
+      h = hashValue(h,curves->subtype);
+      h = hashBuffer(h,curves->curves,sizeof(unsigned int));
+      for (size_t t=0; t<curves->vertices.size(); t++)
+        h = hashBuffer(h,curves->vertices[t],4*sizeof(float));
+      return true;
+    }
+    default:
+      return false;
+    }
+  }
+
+  /*! hashes all geometries of the scene, returns false if the scene contains unsupported geometry */
+  static bool hashScene(Scene* scene, unsigned long long& hash)
+  {
+    std::vector<unsigned long long> hashes(scene->size());
+    std::atomic<bool> supported(true);
+    parallel_for(scene->size(), [&] (size_t i) {
+        if (!hashGeometry(scene->get(i),hashes[i])) supported = false;
+      });
+
+    hash = hashValue(0xcbf29ce484222325ULL,scene->size());
+    for (size_t i=0; i<hashes.size(); i++)
+      hash = hashValue(hash,hashes[i]);
+    return supported;
+  }
+
+  /*! returns the hierarchy of an accel if it can get stored, nullptr otherwise */
+  static BVH4* getStorableBVH(Accel* accel)
+  {
+    if (accel->type != AccelData::TY_ACCEL_INSTANCE) return nullptr;
+    AccelData* data = ((AccelInstance*)accel)->getAccel();
+    if (data->type != AccelData::TY_BVH4) return nullptr;
+    BVH4* bvh = (BVH4*) data;
+    if (bvh->msmblur || bvh->numTimeSteps != 1) return nullptr;
+    if (!isSelfContainedPrimType(bvh->primTy)) return nullptr;
+    return bvh;
+  }
+
+  /*! finds the block a reference points into and relocates the reference, returns false for invalid references */
+  static bool relocate(const std::vector<BVHBlockRelocation>& blocks, BVH4::NodeRef& ref)
+  {
+    if (ref == BVH4::emptyNode) return true;
+    const size_t flags = size_t(ref) & BVH4::align_mask;
+    const size_t ptr   = size_t(ref) & ~BVH4::align_mask;
+    auto block = std::upper_bound(blocks.begin(),blocks.end(),BVHBlockRelocation(ptr,0,0));
+    if (block == blocks.begin()) return false;
+    block--;
+    if (ptr >= block->base+block->bytes) return false;
+    ref = BVH4::NodeRef((block->newBase + (ptr-block->base)) | flags);
+    return true;
+  }
+
+  /*! relocates all references of a subtree, the reference itself gets relocated before its node is accessed */
+  static bool relocateRecursive(const std::vector<BVHBlockRelocation>& blocks, BVH4::NodeRef& ref)
+  {
+    if (!relocate(blocks,ref)) return false;
+    if (ref.isLeaf()) return true;
+
+    if (!ref.isAlignedNode() && !ref.isAlignedNodeMB() && !ref.isUnalignedNode() && !ref.isUnalignedNodeMB() && !ref.isQuantizedNode() && !ref.isHalfNode())
+      return false;
+
+    BVH4::BaseNode* node = ref.baseNode(BVH_AN1_UN1);
+    for (size_t i=0; i<4; i++) {
+      if (!relocateRecursive(blocks,node->child(i)))
+        return false;
+    }
+    return true;
+  }
+
+  /*! verifies that all references of a subtree point into the stored blocks */
+  static bool verifyRecursive(const std::vector<BVHBlockRelocation>& blocks, BVH4::NodeRef ref)
+  {
+    BVH4::NodeRef cref = ref;
+    if (!relocate(blocks,cref)) return false;
+    if (ref.isLeaf()) return true;
+
+    if (!ref.isAlignedNode() && !ref.isAlignedNodeMB() && !ref.isUnalignedNode() && !ref.isUnalignedNodeMB() && !ref.isQuantizedNode() && !ref.isHalfNode())
+      return false;
+
+    const BVH4::BaseNode* node = ref.baseNode(BVH_AN1_UN1);
+    for (size_t i=0; i<4; i++) {
+      if (!verifyRecursive(blocks,node->child(i)))
+        return false;
+    }
+    return true;
+  }
+
+  static void write(FILE* file, const void* ptr, size_t bytes)
+  {
+    if (bytes && fwrite(ptr,bytes,1,file) != 1)
+      throw_RTCError(RTC_UNKNOWN_ERROR,"error writing BVH file");
+  }
+
+  static bool read(FILE* file, void* ptr, size_t bytes) {
+    return bytes == 0 || fread(ptr,bytes,1,file) == 1;
+  }
+
+  void saveBVH(Scene* scene, const std::string& fileName)
+  {
+    double t0 = getSeconds();
+
+    unsigned long long hash = 0;
+    if (!hashScene(scene,hash))
+      throw_RTCError(RTC_INVALID_OPERATION,"BVH files only support triangle, quad, and hair geometry");
+
+    /* all accels that cannot get stored have to be empty */
+    std::vector<size_t> accelIDs;
+    for (size_t i=0; i<scene->accels.accels.size(); i++)
+    {
+      Accel* accel = scene->accels.accels[i];
+      if (getStorableBVH(accel)) accelIDs.push_back(i);
+      else if (!accel->bounds.empty())
+        throw_RTCError(RTC_INVALID_OPERATION,"BVH files are not supported for the selected acceleration structures");
+    }
+
+    FILE* file = fopen(fileName.c_str(),"wb");
+    if (!file) throw_RTCError(RTC_INVALID_OPERATION,"cannot open BVH file for writing");
+
+    try
+    {
+      BVHFileHeader header;
+      memset(&header,0,sizeof(header));
+      memcpy(header.magic,bvhFileMagic,sizeof(header.magic));
+      header.version = bvhFileVersion;
+      header.sizeofNode = sizeof(BVH4::AlignedNode);
+      header.geometryHash = hash;
+      header.numAccels = accelIDs.size();
+      write(file,&header,sizeof(header));
+
+      for (size_t i=0; i<accelIDs.size(); i++)
+      {
+        BVH4* bvh = getStorableBVH(scene->accels.accels[accelIDs[i]]);
+
+        /* gather used memory blocks */
+        std::vector<BVHFileBlock> blockTable;
+        std::vector<BVHBlockRelocation> blocks;
+        size_t numBytes = 0;
+        bvh->alloc.forEachUsedBlock([&] (const char* ptr, size_t bytes) {
+            if (bytes == 0) return;
+            BVHFileBlock block; block.base = (size_t)ptr; block.bytes = bytes;
+            blockTable.push_back(block);
+            blocks.push_back(BVHBlockRelocation((size_t)ptr,bytes,(size_t)ptr));
+            numBytes += (bytes+bvhFileBlockAlignment-1) & ~(bvhFileBlockAlignment-1);
+          });
+        std::sort(blocks.begin(),blocks.end());
+
+        /* all nodes and leaves have to be stored in the allocator blocks */
+        if (!verifyRecursive(blocks,bvh->root))
+          throw_RTCError(RTC_INVALID_OPERATION,"BVH references memory outside of its allocator");
+
+        BVHFileAccel accel;
+        memset(&accel,0,sizeof(accel));
+        accel.accelIndex = accelIDs[i];
+        strncpy(accel.primTy,bvh->primTy.name.c_str(),sizeof(accel.primTy)-1);
+        accel.sizeofPrim = bvh->primTy.bytes;
+        accel.root = (size_t) bvh->root;
+        const LBBox3fa bounds = bvh->getLinearBounds();
+        accel.bounds[0] = bounds.bounds0.lower.x; accel.bounds[1] = bounds.bounds0.lower.y; accel.bounds[2]  = bounds.bounds0.lower.z;
+        accel.bounds[3] = bounds.bounds0.upper.x; accel.bounds[4] = bounds.bounds0.upper.y; accel.bounds[5]  = bounds.bounds0.upper.z;
+        accel.bounds[6] = bounds.bounds1.lower.x; accel.bounds[7] = bounds.bounds1.lower.y; accel.bounds[8]  = bounds.bounds1.lower.z;
+        accel.bounds[9] = bounds.bounds1.upper.x; accel.bounds[10] = bounds.bounds1.upper.y; accel.bounds[11] = bounds.bounds1.upper.z;
+        accel.numPrimitives = bvh->numPrimitives;
+        accel.numVertices = bvh->numVertices;
+        accel.numBlocks = blockTable.size();
+        accel.numBytes = numBytes;
+        write(file,&accel,sizeof(accel));
+        write(file,blockTable.data(),blockTable.size()*sizeof(BVHFileBlock));
+
+        /* write block memory */
+        const char padding[bvhFileBlockAlignment] = { 0 };
+        for (size_t j=0; j<blockTable.size(); j++) {
+          const size_t bytes = blockTable[j].bytes;
+          write(file,(const char*)(size_t)blockTable[j].base,bytes);
+          write(file,padding,((bytes+bvhFileBlockAlignment-1) & ~(bvhFileBlockAlignment-1))-bytes);
+        }
+      }
+    }
+    catch (...) {
+      fclose(file);
+      remove(fileName.c_str());
+      throw;
+    }
+
+    if (fclose(file) != 0)
+      throw_RTCError(RTC_UNKNOWN_ERROR,"error writing BVH file");
+
+    if (scene->device->verbosity(1))
+      std::cout << "stored BVH file " << fileName << " in " << 1000.0f*(getSeconds()-t0) << "ms" << std::endl;
+  }
+
+  bool loadBVH(Scene* scene, const std::string& fileName)
+  {
+    double t0 = getSeconds();
+
+    FILE* file = fopen(fileName.c_str(),"rb");
+    if (!file) return false;
+
+    /* check header */
+    BVHFileHeader header;
+    if (!read(file,&header,sizeof(header)) ||
+        memcmp(header.magic,bvhFileMagic,sizeof(header.magic)) != 0 ||
+        header.version != bvhFileVersion ||
+        header.sizeofNode != sizeof(BVH4::AlignedNode))
+    {
+      fclose(file);
+      return false;
+    }
+
+    /* validate file against scene geometry */
+    unsigned long long hash = 0;
+    std::vector<size_t> accelIDs;
+    for (size_t i=0; i<scene->accels.accels.size(); i++)
+      if (getStorableBVH(scene->accels.accels[i])) accelIDs.push_back(i);
+
+    if (!hashScene(scene,hash) || hash != header.geometryHash || accelIDs.size() != header.numAccels)
+    {
+      if (scene->device->verbosity(1))
+        std::cout << "BVH file " << fileName << " does not match scene" << std::endl;
+      fclose(file);
+      return false;
+    }
+
+    bool valid = true;
+    for (size_t i=0; i<accelIDs.size() && valid; i++)
+    {
+      BVH4* bvh = getStorableBVH(scene->accels.accels[accelIDs[i]]);
+      BVHFileAccel accel;
+      std::vector<BVHFileBlock> blockTable;
+      if (!(valid = read(file,&accel,sizeof(accel)))) break;
+      if (!(valid = accel.accelIndex == accelIDs[i])) break;
+      accel.primTy[sizeof(accel.primTy)-1] = 0;
+      if (!(valid = bvh->primTy.name == accel.primTy && bvh->primTy.bytes == accel.sizeofPrim)) break;
+      blockTable.resize(accel.numBlocks);
+      if (!(valid = read(file,blockTable.data(),blockTable.size()*sizeof(BVHFileBlock)))) break;
+
+      /* read all blocks into a single allocator block */
+      bvh->alloc.clear();
+      char* data = accel.numBytes ? (char*) bvh->alloc.addUsedBlock(accel.numBytes) : nullptr;
+      if (!(valid = read(file,data,accel.numBytes))) break;
+
+      std::vector<BVHBlockRelocation> blocks;
+      size_t offset = 0;
+      for (size_t j=0; j<blockTable.size(); j++) {
+        blocks.push_back(BVHBlockRelocation(blockTable[j].base,blockTable[j].bytes,(size_t)data+offset));
+        offset += (blockTable[j].bytes+bvhFileBlockAlignment-1) & ~(bvhFileBlockAlignment-1);
+      }
+      std::sort(blocks.begin(),blocks.end());
+
+      /* relocate all node references */
+      BVH4::NodeRef root = BVH4::NodeRef(accel.root);
+      if (!(valid = offset == accel.numBytes && relocateRecursive(blocks,root))) break;
+
+      LBBox3fa bounds;
+      bounds.bounds0 = BBox3fa(Vec3fa(accel.bounds[0],accel.bounds[1],accel.bounds[2]),Vec3fa(accel.bounds[3],accel.bounds[4],accel.bounds[5]));
+      bounds.bounds1 = BBox3fa(Vec3fa(accel.bounds[6],accel.bounds[7],accel.bounds[8]),Vec3fa(accel.bounds[9],accel.bounds[10],accel.bounds[11]));
+      bvh->set(root,bounds,accel.numPrimitives);
+      bvh->numVertices = accel.numVertices;
+    }
+    fclose(file);
+
+    /* reset partially loaded hierarchies */
+    if (!valid)
+    {
+      for (size_t i=0; i<accelIDs.size(); i++)
+        getStorableBVH(scene->accels.accels[accelIDs[i]])->clear();
+      if (scene->device->verbosity(1))
+        std::cout << "BVH file " << fileName << " is corrupted" << std::endl;
+      return false;
+    }
+
+    const double dt = getSeconds()-t0;
+    if (scene->device->verbosity(1))
+      std::cout << "loaded BVH file " << fileName << " in " << 1000.0f*dt << "ms" << std::endl;
+
+    if (scene->device->benchmark)
+      std::cout << "BENCHMARK_LOAD " << dt << std::endl;
+
+    return true;
+  }
+}
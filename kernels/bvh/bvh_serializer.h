@@ -0,0 +1,37 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/default.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! Stores all hierarchies of a freshly built static scene to a
+   *  file. The file contains the memory blocks of each BVH together
+   *  with their original addresses, such that node references can
+   *  get relocated on load. Has to get called before the geometry
+   *  buffers of the scene are released. */
+  void saveBVH(Scene* scene, const std::string& fileName);
+
+  /*! Loads all hierarchies of a static scene from a file written by
+   *  saveBVH. Returns false if the file does not exist or does not
+   *  match the geometry of the scene, the scene has to get build in
+   *  that case. */
+  bool loadBVH(Scene* scene, const std::string& fileName);
+}
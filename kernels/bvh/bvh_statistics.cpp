@@ -54,6 +54,7 @@ namespace embree
     if (stat.statUnalignedNodesMB.numNodes) stream << "  unaligneddNodesMB: "  << stat.statUnalignedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statTransformNodes.numNodes  ) stream << "  transformNodes   : "  << stat.statTransformNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statQuantizedNodes.numNodes  ) stream << "  quantizedNodes   : "  << stat.statQuantizedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
+    if (stat.statHalfNodes.numNodes       ) stream << "  halfNodes        : "  << stat.statHalfNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "  leaves           : "  << stat.statLeaf.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "    histogram      : "  << stat.statLeaf.histToString() << std::endl;
     return stream.str();
@@ -135,6 +136,19 @@ namespace embree
       s.statQuantizedNodes.nodeSAH += dt*A;
       s.depth++;
     }
+    else if (node.isHalfNode())
+    {
+      HalfNode* n = node.halfNode();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        s.statHalfNodes.numChildren++;
+        const double Ai = max(0.0f,halfArea(n->extend(i)));
+        s = s + statistics(n->child(i),Ai,t0t1); 
+      }
+      s.statHalfNodes.numNodes++;
+      s.statHalfNodes.nodeSAH += dt*A;
+      s.depth++;
+    }
     else if (node.isLeaf())
     {
       size_t num; const char* tri = node.leaf(num);
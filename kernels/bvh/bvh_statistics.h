@@ -31,6 +31,7 @@ namespace embree
     typedef typename BVH::UnalignedNodeMB UnalignedNodeMB;
     typedef typename BVH::TransformNode TransformNode;
     typedef typename BVH::QuantizedNode QuantizedNode;
+    typedef typename BVH::HalfNode HalfNode;
 
     typedef typename BVH::NodeRef NodeRef;
 
@@ -170,7 +171,8 @@ namespace embree
                   NodeStat<AlignedNodeMB> statAlignedNodesMB = NodeStat<AlignedNodeMB>(),
                   NodeStat<UnalignedNodeMB> statUnalignedNodesMB = NodeStat<UnalignedNodeMB>(),
                   NodeStat<TransformNode> statTransformNodes = NodeStat<TransformNode>(),
-                  NodeStat<QuantizedNode> statQuantizedNodes = NodeStat<QuantizedNode>())
+                  NodeStat<QuantizedNode> statQuantizedNodes = NodeStat<QuantizedNode>(),
+                  NodeStat<HalfNode> statHalfNodes = NodeStat<HalfNode>())
 
       : depth(depth), 
         statLeaf(statLeaf),
@@ -179,7 +181,8 @@ namespace embree
         statAlignedNodesMB(statAlignedNodesMB),
         statUnalignedNodesMB(statUnalignedNodesMB),
         statTransformNodes(statTransformNodes),
-        statQuantizedNodes(statQuantizedNodes) {}
+        statQuantizedNodes(statQuantizedNodes),
+        statHalfNodes(statHalfNodes) {}
 
       double sah(BVH* bvh) const 
       {
@@ -189,7 +192,8 @@ namespace embree
           statAlignedNodesMB.sah(bvh) + 
           statUnalignedNodesMB.sah(bvh) + 
           statTransformNodes.sah(bvh) + 
-          statQuantizedNodes.sah(bvh);
+          statQuantizedNodes.sah(bvh) +
+          statHalfNodes.sah(bvh);
       }
       
       size_t bytes(BVH* bvh) const {
@@ -199,7 +203,8 @@ namespace embree
           statAlignedNodesMB.bytes() + 
           statUnalignedNodesMB.bytes() + 
           statTransformNodes.bytes() + 
-          statQuantizedNodes.bytes();
+          statQuantizedNodes.bytes() +
+          statHalfNodes.bytes();
       }
 
       size_t size() const 
@@ -210,7 +215,8 @@ namespace embree
           statAlignedNodesMB.size() + 
           statUnalignedNodesMB.size() + 
           statTransformNodes.size() + 
-          statQuantizedNodes.size();
+          statQuantizedNodes.size() +
+          statHalfNodes.size();
       }
 
       double fillRate (BVH* bvh) const 
@@ -221,14 +227,16 @@ namespace embree
           statAlignedNodesMB.fillRateNom() + 
           statUnalignedNodesMB.fillRateNom() + 
           statTransformNodes.fillRateNom() + 
-          statQuantizedNodes.fillRateNom();
+          statQuantizedNodes.fillRateNom() +
+          statHalfNodes.fillRateNom();
         double den = statLeaf.fillRateDen(bvh) +
           statAlignedNodes.fillRateDen() + 
           statUnalignedNodes.fillRateDen() + 
           statAlignedNodesMB.fillRateDen() + 
           statUnalignedNodesMB.fillRateDen() + 
           statTransformNodes.fillRateDen() + 
-          statQuantizedNodes.fillRateDen();
+          statQuantizedNodes.fillRateDen() +
+          statHalfNodes.fillRateDen();
         return nom/den;
       }
 
@@ -241,7 +249,8 @@ namespace embree
                           a.statAlignedNodesMB + b.statAlignedNodesMB,
                           a.statUnalignedNodesMB + b.statUnalignedNodesMB,
                           a.statTransformNodes + b.statTransformNodes,
-                          a.statQuantizedNodes + b.statQuantizedNodes);
+                          a.statQuantizedNodes + b.statQuantizedNodes,
+                          a.statHalfNodes + b.statHalfNodes);
       }
 
     public:
@@ -253,6 +262,7 @@ namespace embree
       NodeStat<UnalignedNodeMB> statUnalignedNodesMB;
       NodeStat<TransformNode> statTransformNodes;
       NodeStat<QuantizedNode> statQuantizedNodes;
+      NodeStat<HalfNode> statHalfNodes;
     };
 
   public:
@@ -271,6 +281,14 @@ namespace embree
       return stat.bytes(bvh);
     }
 
+    size_t bytesLeaves() const {
+      return stat.statLeaf.bytes(bvh);
+    }
+
+    size_t numTransformNodes() const {
+      return stat.statTransformNodes.numNodes;
+    }
+
   private:
     Statistics statistics(NodeRef node, const double A, const BBox1f dt);
 
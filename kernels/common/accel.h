@@ -40,6 +40,12 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! returns the name of the primitive type stored in the acceleration structure */
+    virtual const char* getName() const { return nullptr; }
+
+    /*! adds the memory consumption of the acceleration structure to the statistics */
+    virtual void addMemoryStatistics(RTCMemoryStatistics& stats) {}
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
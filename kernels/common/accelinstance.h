@@ -31,6 +31,11 @@ namespace embree
       delete builder; builder = nullptr;
     }
 
+    /*! returns the wrapped acceleration structure */
+    AccelData* getAccel() const {
+      return accel;
+    }
+
     ~AccelInstance() {
       delete builder; builder = nullptr;
       delete accel;   accel = nullptr;
@@ -52,6 +57,14 @@ namespace embree
       builder->clear();
     }
 
+    const char* getName() const {
+      return accel->getName();
+    }
+
+    void addMemoryStatistics(RTCMemoryStatistics& stats) {
+      accel->addMemoryStatistics(stats);
+    }
+
   private:
     AccelData* accel;
     Builder* builder;
@@ -154,13 +154,31 @@ namespace embree
       accels[i]->immutable();
   }
   
+  void AccelN::replace(size_t i, Accel* accel)
+  {
+    assert(i < accels.size() && accel);
+    delete accels[i];
+    accels[i] = accel;
+    validAccels.clear();
+  }
+
   void AccelN::build (size_t threadIndex, size_t threadCount) 
   {
     /* build all acceleration structures in parallel */
     parallel_for (accels.size(), [&] (size_t i) { 
         accels[i]->build(threadIndex,threadCount);
       });
+    selectValidAccels();
+  }
 
+  void AccelN::rebuild (size_t i)
+  {
+    accels[i]->build(0,0);
+    selectValidAccels();
+  }
+
+  void AccelN::selectValidAccels()
+  {
     /* create list of non-empty acceleration structures */
     validAccels.clear();
     validIntersectorN = true;
@@ -30,6 +30,9 @@ namespace embree
   public:
     void add(Accel* accel);
 
+    /*! replaces acceleration structure i, the new one has to get built before use */
+    void replace(size_t i, Accel* accel);
+
   public:
     static void intersect (void* ptr, RTCRay& ray, IntersectContext* context);
     static void intersect4 (const void* valid, void* ptr, RTCRay4& ray, IntersectContext* context);
@@ -48,10 +51,13 @@ namespace embree
     void print(size_t ident);
     void immutable();
     void build (size_t threadIndex, size_t threadCount);
+    void rebuild (size_t i);
     void select(bool filter4, bool filter8, bool filter16, bool filterN);
     void deleteGeometry(size_t geomID);
     void clear ();
     __forceinline bool validIsecN() { return validIntersectorN; }
+  private:
+    void selectValidAccels();
 
   public:
     darray_t<Accel*,16> accels;
@@ -80,6 +80,56 @@ namespace embree
   };
 
   fast_allocator_regression_test fast_allocator_regression;
+
+  struct fast_allocator_retain_regression_test : public RegressionTest, public MemoryMonitorInterface
+  {
+    std::atomic<ssize_t> bytesAllocated;
+    std::atomic<size_t> numAllocations;
+
+    fast_allocator_retain_regression_test() 
+      : RegressionTest("fast_allocator_retain_regression_test"), bytesAllocated(0), numAllocations(0)
+    {
+      registerRegressionTest(this);
+    }
+
+    void memoryMonitor(ssize_t bytes, bool post) 
+    {
+      bytesAllocated += bytes;
+      if (bytes > 0) numAllocations++;
+    }
+
+    /* emulates one build that allocates the specified amount of memory */
+    void build(FastAllocator& alloc, size_t bytes)
+    {
+      alloc.init_estimate(bytes);
+      FastAllocator::ThreadLocal* threadalloc = alloc.threadLocal2()->alloc0;
+      for (size_t i=0; i<bytes; i+=256)
+        threadalloc->malloc(256);
+      alloc.cleanup();
+    }
+    
+    bool run ()
+    {
+      bool passed = true;
+      {
+        FastAllocator alloc(this,false,1.5f);
+        
+        /* builds that do not exceed the high-water mark reuse the retained blocks */
+        build(alloc,16*1024*1024);
+        const size_t numAllocationsFirstBuild = numAllocations;
+        for (size_t i=0; i<4; i++) build(alloc,(i%2) ? 16*1024*1024 : 4*1024*1024);
+        passed &= numAllocations == numAllocationsFirstBuild;
+
+        /* blocks get released once the high-water mark dropped for enough builds */
+        for (size_t i=0; i<16; i++) build(alloc,1024*1024);
+        passed &= bytesAllocated < 8*1024*1024;
+      }
+      passed &= bytesAllocated == 0;
+      return passed;
+    }
+  };
+
+  fast_allocator_retain_regression_test fast_allocator_retain_regression;
 }
 
 
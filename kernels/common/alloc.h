@@ -33,6 +33,15 @@ namespace embree
     //static const size_t defaultBlockSize = 4096;
 #define maxAllocationSize size_t(4*1024*1024-maxAlignment)
     static const size_t MAX_THREAD_USED_BLOCK_SLOTS = 8;
+
+    /*! maximal number of NUMA nodes with separate block pools, each node uses at least one block slot */
+    static const size_t MAX_NUMA_NODES = MAX_THREAD_USED_BLOCK_SLOTS;
+
+    /*! number of builds the high-water mark for block retention is taken over */
+    static const size_t RETAIN_HISTORY = 8;
+
+    /*! maximal size of the blocks handed out to threads, independent of the OS page size */
+    static const size_t maxDefaultBlockSize = 4096;
     
   public:
 
@@ -166,8 +175,12 @@ namespace embree
       ThreadLocal* alloc1;
     };
 
-    FastAllocator (MemoryMonitorInterface* device) 
-      : device(device), slotMask(0), usedBlocks(nullptr), freeBlocks(nullptr), use_single_mode(false), defaultBlockSize(PAGE_SIZE), growSize(PAGE_SIZE), log2_grow_size_scale(0), bytesUsed(0), bytesWasted(0), thread_local_allocators2(this)
+    /*! Constructor, when numa is set memory blocks get placed on the NUMA node of the thread that
+     *  uses them. Blocks stay committed across rebuilds, retainFactor limits the free blocks kept 
+     *  after a build relative to the high-water mark of the last builds, 0 keeps all blocks. */
+    FastAllocator (MemoryMonitorInterface* device, bool numa = false, float retainFactor = 0.0f) 
+      : device(device), slotMask(0), numaNodes(numa ? computeNumaNodes() : 1), usedBlocks(nullptr), use_single_mode(false), defaultBlockSize(maxDefaultBlockSize), growSize(getPageSize()), maxGrowSize(computeMaxGrowSize()), log2_grow_size_scale(0), bytesUsed(0), bytesWasted(0), 
+      retainFactor(retainFactor), retainIndex(0), thread_local_allocators2(this)
     {
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
@@ -175,6 +188,10 @@ namespace embree
         threadBlocks[i] = nullptr;
         assert(!slotMutex[i].isLocked());
       }
+      for (size_t i=0; i<MAX_NUMA_NODES; i++)
+        freeBlocks[i] = nullptr;
+      for (size_t i=0; i<RETAIN_HISTORY; i++)
+        retainHistory[i] = 0;
     }
 
     ~FastAllocator () { 
@@ -192,6 +209,33 @@ namespace embree
       return thread_local_allocators2.get();
     }
 
+    /*! number of NUMA nodes with separate block pools, rounded down to a power of two */
+    static size_t computeNumaNodes()
+    {
+      const size_t numNodes = min(getNumberOfNumaNodes(),MAX_NUMA_NODES);
+      size_t n = 1; while (2*n <= numNodes) n *= 2;
+      return n;
+    }
+
+    /*! returns the block slot of the calling thread and the NUMA node the slot belongs to, 
+     *  the slots get distributed evenly over the NUMA nodes */
+    __forceinline size_t threadSlot(size_t& node) const
+    {
+      const size_t threadIndex = TaskScheduler::threadIndex();
+      if (likely(numaNodes == 1)) { node = 0; return threadIndex & slotMask; }
+      node = getNumaNode() & (numaNodes-1);
+      const size_t slotsPerNode = MAX_THREAD_USED_BLOCK_SLOTS/numaNodes;
+      return node*slotsPerNode + (threadIndex & slotMask & (slotsPerNode-1));
+    }
+
+    /*! checks if any free blocks are available */
+    __forceinline bool hasFreeBlocks() const 
+    {
+      for (size_t i=0; i<numaNodes; i++)
+        if (freeBlocks[i].load()) return true;
+      return false;
+    }
+
     void internal_fix_used_blocks()
     {
 #if ENABLE_PARALLEL_BLOCK_ALLOCATION == 1
@@ -215,12 +259,18 @@ namespace embree
       internal_fix_used_blocks();
       /* distribute the allocation to multiple thread block slots */
       slotMask = MAX_THREAD_USED_BLOCK_SLOTS-1;      
-      if (usedBlocks.load() || freeBlocks.load()) { reset(); return; }
+      if (usedBlocks.load() || hasFreeBlocks()) { reset(); return; }
       if (bytesReserve == 0) bytesReserve = bytesAllocate;
-      freeBlocks = Block::create(device,bytesAllocate,bytesReserve);
+      if (numaNodes == 1)
+        freeBlocks[0] = Block::create(device,bytesAllocate,bytesReserve);
+      else {
+        /* split the initial allocation over the NUMA nodes, nodes that run out grow their own pool */
+        for (size_t i=0; i<numaNodes; i++)
+          freeBlocks[i] = Block::create(device,bytesAllocate/numaNodes,bytesReserve/numaNodes,nullptr,i);
+      }
       use_single_mode = false; //bytesAllocate < 8*PAGE_SIZE;
-      defaultBlockSize = clamp(bytesAllocate/4,size_t(128),size_t(PAGE_SIZE));
-      growSize = clamp(bytesReserve,size_t(PAGE_SIZE),maxAllocationSize);
+      defaultBlockSize = clamp(bytesAllocate/4,size_t(128),maxDefaultBlockSize);
+      growSize = clamp(bytesReserve,getPageSize(),maxAllocationSize);
       log2_grow_size_scale = 0;
     }
 
@@ -228,10 +278,10 @@ namespace embree
     void init_estimate(size_t bytesAllocate) 
     {
       internal_fix_used_blocks();
-      if (usedBlocks.load() || freeBlocks.load()) { reset(); return; }
+      if (usedBlocks.load() || hasFreeBlocks()) { reset(); return; }
       use_single_mode = false; //bytesAllocate < 8*PAGE_SIZE;
-      defaultBlockSize = clamp(bytesAllocate/4,size_t(128),size_t(PAGE_SIZE));
-      growSize = clamp(bytesAllocate,size_t(PAGE_SIZE),maxAllocationSize);
+      defaultBlockSize = clamp(bytesAllocate/4,size_t(128),maxDefaultBlockSize);
+      growSize = clamp(bytesAllocate,getPageSize(),maxAllocationSize);
       log2_grow_size_scale = 0;
       if (MAX_THREAD_USED_BLOCK_SLOTS >= 0                                        ) slotMask = 0x0;
       if (MAX_THREAD_USED_BLOCK_SLOTS >= 2 && bytesAllocate >  4*maxAllocationSize) slotMask = 0x1;
@@ -250,6 +300,38 @@ namespace embree
       }
 
       thread_local_allocators2.clear();
+      trim();
+    }
+
+    /*! releases the free blocks that exceed the retention budget, the budget is retainFactor 
+     *  times the maximal memory used by one of the last RETAIN_HISTORY builds */
+    void trim()
+    {
+      if (retainFactor <= 0.0f) return;
+      
+      const size_t bytesUsedBlocks = usedBlocks.load() ? usedBlocks.load()->getAllocatedBytes() : 0;
+      retainHistory[retainIndex++ % RETAIN_HISTORY] = bytesUsedBlocks;
+      size_t highWaterMark = 0;
+      for (size_t i=0; i<RETAIN_HISTORY; i++)
+        highWaterMark = max(highWaterMark,retainHistory[i]);
+      const size_t bytesRetain = size_t(retainFactor*float(highWaterMark));
+
+      /* keep the free blocks in order until the budget is exhausted */
+      size_t bytesKept = bytesUsedBlocks;
+      for (size_t i=0; i<numaNodes; i++)
+      {
+        Block* keep = nullptr;
+        Block** tail = &keep;
+        for (Block* block = freeBlocks[i].load(); block; ) 
+        {
+          Block* next = block->next; block->next = nullptr;
+          const size_t bytes = block->getBlockAllocatedBytes();
+          if (bytesKept+bytes <= bytesRetain) { bytesKept += bytes; *tail = block; tail = &block->next; }
+          else block->clear(device);
+          block = next;
+        }
+        freeBlocks[i] = keep;
+      }
     }
 
     /*! shrinks all memory blocks to the actually used size */
@@ -258,7 +340,9 @@ namespace embree
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
         if (threadUsedBlocks[i].load() != nullptr) threadUsedBlocks[i].load()->shrink(device);
       if (usedBlocks.load() != nullptr) usedBlocks.load()->shrink(device);
-      if (freeBlocks.load() != nullptr) freeBlocks.load()->clear(device); freeBlocks = nullptr;
+      for (size_t i=0; i<numaNodes; i++) {
+        if (freeBlocks[i].load() != nullptr) freeBlocks[i].load()->clear(device); freeBlocks[i] = nullptr;
+      }
     }
 
     /*! resets the allocator, memory blocks get reused */
@@ -272,11 +356,13 @@ namespace embree
       /* first reset all used blocks */
       if (usedBlocks.load() != nullptr) usedBlocks.load()->reset();
       
-      /* move all used blocks to begin of free block list */
+      /* move all used blocks to begin of the free block list of their NUMA node */
       while (usedBlocks.load() != nullptr) {
-        Block* nextUsedBlock = usedBlocks.load()->next;
-        usedBlocks.load()->next = freeBlocks.load();
-        freeBlocks = usedBlocks.load();
+        Block* block = usedBlocks.load();
+        Block* nextUsedBlock = block->next;
+        const size_t node = block->numaNode & (numaNodes-1);
+        block->next = freeBlocks[node].load();
+        freeBlocks[node] = block;
         usedBlocks = nextUsedBlock;
       }
 
@@ -297,11 +383,43 @@ namespace embree
       bytesUsed = 0;
       bytesWasted = 0;
       if (usedBlocks.load() != nullptr) usedBlocks.load()->clear(device); usedBlocks = nullptr;
-      if (freeBlocks.load() != nullptr) freeBlocks.load()->clear(device); freeBlocks = nullptr;
+      for (size_t i=0; i<numaNodes; i++) {
+        if (freeBlocks[i].load() != nullptr) freeBlocks[i].load()->clear(device); freeBlocks[i] = nullptr;
+      }
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++) {
         threadUsedBlocks[i] = nullptr;
         threadBlocks[i] = nullptr;
       }
+      for (size_t i=0; i<RETAIN_HISTORY; i++)
+        retainHistory[i] = 0;
+    }
+
+    /*! calls func(ptr,bytes) for the used memory region of each block */
+    template<typename Func>
+    void forEachUsedBlock(const Func& func)
+    {
+      internal_fix_used_blocks();
+      for (Block* block = usedBlocks.load(); block; block = block->next)
+        func((const char*)&block->data[0],block->getBlockUsedBytes());
+    }
+
+    /*! adds a new block that is completely marked as used, used to load previously stored data */
+    void* addUsedBlock(size_t bytes)
+    {
+      Block* block = Block::create(device,bytes,bytes,usedBlocks);
+      block->cur = bytes;
+      usedBlocks = block;
+      bytesUsed += bytes;
+      return &block->data[0];
+    }
+
+    /*! blocks grow up to two huge pages such that large scenes get backed by huge pages, 
+     *  huge pages larger than 32MB as used by 64KB page kernels are not worth it */
+    static size_t computeMaxGrowSize()
+    {
+      const size_t hugePageSize = getHugePageSize();
+      if (hugePageSize > 32*1024*1024) return maxAllocationSize+maxAlignment;
+      return max(2*hugePageSize,size_t(maxAllocationSize+maxAlignment));
     }
 
     __forceinline size_t incGrowSizeScale()
@@ -318,8 +436,8 @@ namespace embree
       while (true) 
       {
         /* allocate using current block */
-        size_t threadIndex = TaskScheduler::threadIndex();
-        size_t slot = threadIndex & slotMask;
+        size_t node = 0;
+        const size_t slot = threadSlot(node);
 	Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial); 
@@ -332,12 +450,12 @@ namespace embree
 
 #if ENABLE_PARALLEL_BLOCK_ALLOCATION == 1
         /* parallel block creation in case of no freeBlocks, avoids single global mutex */
-        if (likely(freeBlocks.load() == nullptr)) 
+        if (likely(freeBlocks[node].load() == nullptr)) 
         {
           Lock<SpinLock> lock(slotMutex[slot]);
           if (myUsedBlocks == threadUsedBlocks[slot]) {
-            const size_t allocSize = min(growSize * incGrowSizeScale(),size_t(maxAllocationSize+maxAlignment))-maxAlignment;
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot]);              
+            const size_t allocSize = min(growSize * incGrowSizeScale(),maxGrowSize)-maxAlignment;
+            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],blockNode(node));
           }
           continue;
         }        
@@ -348,17 +466,17 @@ namespace embree
           Lock<SpinLock> lock(mutex);
 	  if (myUsedBlocks == threadUsedBlocks[slot])
 	  {
-            if (freeBlocks.load() != nullptr) {
-	      Block* nextFreeBlock = freeBlocks.load()->next;
-	      freeBlocks.load()->next = usedBlocks;
+            if (freeBlocks[node].load() != nullptr) {
+	      Block* nextFreeBlock = freeBlocks[node].load()->next;
+	      freeBlocks[node].load()->next = usedBlocks;
 	      __memory_barrier();
-	      usedBlocks = freeBlocks.load();
-              threadUsedBlocks[slot] = freeBlocks.load();
-	      freeBlocks = nextFreeBlock;
+	      usedBlocks = freeBlocks[node].load();
+              threadUsedBlocks[slot] = freeBlocks[node].load();
+	      freeBlocks[node] = nextFreeBlock;
 	    } else {
 	      //growSize = min(2*growSize,size_t(maxAllocationSize+maxAlignment));
-              const size_t allocSize = min(growSize * incGrowSizeScale(),size_t(maxAllocationSize+maxAlignment))-maxAlignment;
-	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks);
+              const size_t allocSize = min(growSize * incGrowSizeScale(),maxGrowSize)-maxAlignment;
+	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,blockNode(node));
 	    }
 	  }
         }
@@ -369,16 +487,18 @@ namespace embree
     void* specialAlloc(size_t bytes) 
     {
       /* create a new block if the first free block is too small */
-      if (freeBlocks.load() == nullptr || freeBlocks.load()->getBlockAllocatedBytes() < bytes)
-        freeBlocks = Block::create(device,bytes,bytes,freeBlocks);
+      size_t node = 0; threadSlot(node);
+      if (freeBlocks[node].load() == nullptr || freeBlocks[node].load()->getBlockAllocatedBytes() < bytes)
+        freeBlocks[node] = Block::create(device,bytes,bytes,freeBlocks[node],blockNode(node));
 
-      return freeBlocks.load()->ptr();
+      return freeBlocks[node].load()->ptr();
     }
 
     size_t getAllocatedBytes() const 
     {
       size_t bytesAllocated = 0;
-      if (freeBlocks.load()) bytesAllocated += freeBlocks.load()->getAllocatedBytes();
+      for (size_t i=0; i<numaNodes; i++)
+        if (freeBlocks[i].load()) bytesAllocated += freeBlocks[i].load()->getAllocatedBytes();
       if (usedBlocks.load()) bytesAllocated += usedBlocks.load()->getAllocatedBytes();
       return bytesAllocated;
     }
@@ -386,7 +506,8 @@ namespace embree
     size_t getReservedBytes() const 
     {
       size_t bytesReserved = 0;
-      if (freeBlocks.load()) bytesReserved += freeBlocks.load()->getReservedBytes();
+      for (size_t i=0; i<numaNodes; i++)
+        if (freeBlocks[i].load()) bytesReserved += freeBlocks[i].load()->getReservedBytes();
       if (usedBlocks.load()) bytesReserved += usedBlocks.load()->getReservedBytes();
       return bytesReserved;
     }
@@ -404,7 +525,8 @@ namespace embree
     size_t getFreeBytes() const 
     {
       size_t bytesFree = 0;
-      if (freeBlocks.load()) bytesFree += freeBlocks.load()->getAllocatedBytes();
+      for (size_t i=0; i<numaNodes; i++)
+        if (freeBlocks[i].load()) bytesFree += freeBlocks[i].load()->getAllocatedBytes();
       return bytesFree;
     }
 
@@ -435,36 +557,47 @@ namespace embree
       if (verbose) 
       {
         std::cout << "  slotMask = " << slotMask << std::endl;
+        std::cout << "  numaNodes = " << numaNodes << std::endl;
+        std::cout << "  retainFactor = " << retainFactor << std::endl;
         std::cout << "  use_single_mode = " << use_single_mode << std::endl;
         std::cout << "  defaultBlockSize = " << defaultBlockSize << std::endl;
         std::cout << "  used blocks = ";
         if (usedBlocks.load() != nullptr) usedBlocks.load()->print();
         std::cout << "[END]" << std::endl;
         
-        std::cout << "  free blocks = ";
-        if (freeBlocks.load() != nullptr) freeBlocks.load()->print();
-        std::cout << "[END]" << std::endl;
+        for (size_t i=0; i<numaNodes; i++) {
+          std::cout << "  free blocks[" << i << "] = ";
+          if (freeBlocks[i].load() != nullptr) freeBlocks[i].load()->print();
+          std::cout << "[END]" << std::endl;
+        }
       }
     }
 
   private:
 
+    /*! NUMA node to bind new blocks to, -1 leaves the placement to the OS */
+    __forceinline ssize_t blockNode(size_t node) const {
+      return numaNodes > 1 ? ssize_t(node) : ssize_t(-1);
+    }
+
     struct Block 
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next = nullptr)
+      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next = nullptr, ssize_t numaNode = -1)
       {
         const size_t sizeof_Header = offsetof(Block,data[0]);
-        bytesAllocate = ((sizeof_Header+bytesAllocate+PAGE_SIZE-1) & ~(PAGE_SIZE-1)); // always consume full pages
-        bytesReserve  = ((sizeof_Header+bytesReserve +PAGE_SIZE-1) & ~(PAGE_SIZE-1)); // always consume full pages
+        const size_t pageSize = getPageSize();
+        bytesAllocate = ((sizeof_Header+bytesAllocate+pageSize-1) & ~(pageSize-1)); // always consume full pages
+        bytesReserve  = ((sizeof_Header+bytesReserve +pageSize-1) & ~(pageSize-1)); // always consume full pages
         if (device) device->memoryMonitor(bytesAllocate,false);
         void* ptr = os_reserve(bytesReserve);
+        if (numaNode >= 0) os_bind_numa(ptr,bytesReserve,numaNode); // has to happen before the header touches the first page
         os_commit(ptr,bytesAllocate);
-        new (ptr) Block(bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next);
+        new (ptr) Block(bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,numaNode >= 0 ? numaNode : 0);
         return (Block*) ptr;
       }
 
-      Block (size_t bytesAllocate, size_t bytesReserve, Block* next) 
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next) 
+      Block (size_t bytesAllocate, size_t bytesReserve, Block* next, size_t numaNode) 
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), numaNode(numaNode) 
       {
         //for (size_t i=0; i<allocEnd; i+=defaultBlockSize) data[i] = 0;
       }
@@ -558,7 +691,8 @@ namespace embree
       std::atomic<size_t> allocEnd;   //!< end of the allocated memory region
       std::atomic<size_t> reserveEnd; //!< end of the reserved memory region
       Block* next;               //!< pointer to next block in list
-      char align[maxAlignment-4*sizeof(size_t)]; //!< align data to maxAlignment
+      size_t numaNode;           //!< NUMA node the block memory is bound to
+      char align[maxAlignment-5*sizeof(size_t)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -567,9 +701,10 @@ namespace embree
     MemoryMonitorInterface* device;
     SpinLock mutex;
     size_t slotMask;
+    size_t numaNodes;            //!< number of NUMA nodes with separate free block lists
     std::atomic<Block*> threadUsedBlocks[MAX_THREAD_USED_BLOCK_SLOTS];
     std::atomic<Block*> usedBlocks;
-    std::atomic<Block*> freeBlocks;
+    std::atomic<Block*> freeBlocks[MAX_NUMA_NODES];
 
     std::atomic<Block*> threadBlocks[MAX_THREAD_USED_BLOCK_SLOTS];
     SpinLock slotMutex[MAX_THREAD_USED_BLOCK_SLOTS];
@@ -577,10 +712,15 @@ namespace embree
     bool use_single_mode;
     size_t defaultBlockSize;
     size_t growSize;
+    size_t maxGrowSize;          //!< maximal size of newly created blocks
     std::atomic<size_t> log2_grow_size_scale; //!< log2 of scaling factor for grow size
     size_t bytesUsed;            //!< number of total bytes used
     size_t bytesWasted;          //!< number of total wasted bytes
 
+    float retainFactor;          //!< free blocks get kept up to this factor times the high-water mark, 0 keeps all blocks
+    size_t retainHistory[RETAIN_HISTORY]; //!< bytes of the used blocks of the last builds
+    size_t retainIndex;          //!< next entry of the retain history to overwrite
+
     ThreadLocalData<ThreadLocal2> thread_local_allocators2; //!< thread local allocators
   };
 }
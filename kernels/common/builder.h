@@ -22,6 +22,7 @@
 namespace embree
 {
 #define MODE_HIGH_QUALITY (1<<8)
+#define MODE_HALF_NODES   (1<<9)
 
   /*! virtual interface for all hierarchy builders */
   class Builder : public RefCount {
@@ -26,6 +26,7 @@
 
 #include "acceln.h"
 #include "geometry.h"
+#include "sah_calibration.h"
 
 #include "../geometry/cylinder.h"
 #include "../geometry/cone.h"
@@ -58,6 +59,7 @@ namespace embree
   static MutexSys g_mutex;
   static std::map<Device*,size_t> g_cache_size_map;
   static std::map<Device*,size_t> g_num_threads_map;
+  static Device* g_tasking_host_device = nullptr;
 
   Device::Device (const char* cfg, bool singledevice)
     : State(singledevice)
@@ -70,6 +72,10 @@ namespace embree
       State::parseFile(FileName::homeFolder()+FileName(".embree" TOSTRING(__EMBREE_VERSION_MAJOR__)));
     State::verify();
 
+    /*! measure SAH costs for this CPU */
+    if (State::sah_calibrate)
+      calibrateSAHCosts(this);
+
     /*! do some internal tests */
     assert(isa::Cylinder::verify());
     assert(isa::Cone::verify());
@@ -296,6 +302,10 @@ namespace embree
 
   size_t getMaxNumThreads()
   {
+    /* the host tasking system executes all tasks, thus no worker threads are required */
+    if (g_tasking_host_device) 
+      return 1;
+
     size_t maxNumThreads = 0;
     for (std::map<Device*,size_t>::iterator i=g_num_threads_map.begin(); i != g_num_threads_map.end(); i++)
       maxNumThreads = max(maxNumThreads, (*i).second);
@@ -319,7 +329,7 @@ namespace embree
     else            g_cache_size_map[this] = bytes;
     
     size_t maxCacheSize = getMaxCacheSize();
-    resizeTessellationCache(maxCacheSize);
+    resizeTessellationCache(maxCacheSize,State::tessellation_cache_numa);
   }
 
   void Device::initTaskingSystem(size_t numThreads) 
@@ -332,6 +342,7 @@ namespace embree
 
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
+    setAffinityPolicy(State::affinity_policy);
     TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
 #if USE_TASK_ARENA
     arena.reset(new tbb::task_arena(int(maxNumThreads)));
@@ -343,6 +354,14 @@ namespace embree
     Lock<MutexSys> lock(g_mutex);
     g_num_threads_map.erase(this);
 
+#if defined(TASKING_INTERNAL)
+    /* return to the internal thread pool when the device that registered the host tasking system gets destroyed */
+    if (g_tasking_host_device == this) {
+      TaskScheduler::setHostInterface(nullptr);
+      g_tasking_host_device = nullptr;
+    }
+#endif
+
     /* terminate tasking system */
     if (g_num_threads_map.size() == 0) {
       TaskScheduler::destroy();
@@ -357,6 +376,36 @@ namespace embree
 #endif
   }
 
+  void Device::setTaskingInterface(const RTCTaskingInterface* tasking)
+  {
+#if defined(TASKING_INTERNAL)
+    if (tasking && (tasking->parallelFor == nullptr || tasking->threadIndex == nullptr || tasking->threadCount == 0))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"incomplete tasking interface");
+
+    Lock<MutexSys> lock(g_mutex);
+    if (tasking) 
+    {
+      TaskScheduler::HostInterface host;
+      host.parallelFor = tasking->parallelFor;
+      host.threadIndex = tasking->threadIndex;
+      host.threadCount = tasking->threadCount;
+      host.userPtr     = tasking->userPtr;
+      TaskScheduler::setHostInterface(&host);
+      g_tasking_host_device = this;
+    }
+    else if (g_tasking_host_device == this) 
+    {
+      TaskScheduler::setHostInterface(nullptr);
+      g_tasking_host_device = nullptr;
+    }
+
+    /* stops the internal worker threads or starts them again */
+    TaskScheduler::create(getMaxNumThreads(),State::set_affinity,State::start_threads);
+#else
+    throw_RTCError(RTC_INVALID_OPERATION,"host tasking interface requires the internal tasking system");
+#endif
+  }
+
   void Device::setParameter1i(const RTCParameter parm, ssize_t val)
   {
     /* hidden internal parameters */
@@ -59,6 +59,9 @@ namespace embree
     /*! invokes the memory monitor callback */
     void memoryMonitor(ssize_t bytes, bool post);
 
+    /*! lets all parallel work run on the tasking system of the host application */
+    void setTaskingInterface(const RTCTaskingInterface* tasking);
+
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
@@ -33,7 +33,56 @@ namespace embree
     parent->setModified();
   }
 
-  Geometry::~Geometry() {
+  Geometry::~Geometry() 
+  {
+    for (size_t i=0; i<fileBuffers.size(); i++)
+      os_unmap_file(fileBuffers[i].ptr,fileBuffers[i].bytes);
+  }
+
+  void Geometry::setFileBuffer(RTCBufferType type, const char* fileName, size_t offset, size_t stride, size_t num)
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    if (num == 0 || num < getBufferSize(type))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"file buffer contains too few elements");
+
+    /* vertex buffers are read with 16 byte loads, thus the 4 bytes after the last vertex have to be inside the mapped range */
+    size_t bytes = num*stride;
+    if ((type & 0xFF000000) == RTC_VERTEX_BUFFER) bytes = (num-1)*stride + max(stride,size_t(16));
+
+    void* ptr = os_map_file(fileName,offset,bytes);
+    if (ptr == nullptr)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"cannot map "+std::to_string(bytes)+" bytes at offset "+std::to_string(offset)+" of file "+std::string(fileName));
+
+    try {
+      setBuffer(type,ptr,0,stride);
+    } catch (...) {
+      os_unmap_file(ptr,bytes);
+      throw;
+    }
+    
+    /* builders read the buffer front to back */
+    os_advise(ptr,bytes,true);
+    unmapFileBuffer(type);
+    fileBuffers.push_back(FileBuffer(type,ptr,bytes));
+  }
+
+  void Geometry::unmapFileBuffer(RTCBufferType type)
+  {
+    for (size_t i=0; i<fileBuffers.size(); i++) 
+    {
+      if (fileBuffers[i].type != type) continue;
+      os_unmap_file(fileBuffers[i].ptr,fileBuffers[i].bytes);
+      fileBuffers.erase(fileBuffers.begin()+i);
+      return;
+    }
+  }
+
+  void Geometry::adviseFileBuffers(bool sequential)
+  {
+    for (size_t i=0; i<fileBuffers.size(); i++) 
+      os_advise(fileBuffers[i].ptr,fileBuffers[i].bytes,sequential);
   }
 
   void Geometry::write(std::ofstream& file) {
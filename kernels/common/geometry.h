@@ -161,6 +161,21 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Returns the number of elements of the specified buffer. */
+    virtual size_t getBufferSize(RTCBufferType type) const {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+      return 0;
+    }
+
+    /*! Sets specified buffer to a read-only mapping of num elements of a file. */
+    void setFileBuffer(RTCBufferType type, const char* fileName, size_t offset, size_t stride, size_t num);
+
+    /*! Releases the file mapping of the specified buffer. */
+    void unmapFileBuffer(RTCBufferType type);
+
+    /*! Hints the OS how file mapped buffers get accessed. */
+    void adviseFileBuffers(bool sequential);
+
     /*! Set displacement function. */
     virtual void setDisplacementFunction (RTCDisplacementFunc filter, RTCBounds* bounds) {
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -470,6 +485,18 @@ namespace embree
     void* userPtr;             //!< user pointer
     unsigned mask;             //!< for masking out geometry
     std::atomic<size_t> used;  //!< counts by how many enabled instances this geometry is used
+
+  private:
+    struct FileBuffer 
+    {
+      FileBuffer (RTCBufferType type, void* ptr, size_t bytes)
+        : type(type), ptr(ptr), bytes(bytes) {}
+
+      RTCBufferType type;      //!< buffer the file is mapped to
+      void* ptr;               //!< start of the mapped range
+      size_t bytes;            //!< number of mapped bytes
+    };
+    std::vector<FileBuffer> fileBuffers; //!< buffers that are mapped from files
     
   public:
     RTCFilterFunc intersectionFilter1;
@@ -176,6 +176,16 @@ namespace embree
     RTCORE_CATCH_END(device);
   }
 
+  RTCORE_API void rtcDeviceSetTaskingInterface(RTCDevice hdevice, const RTCTaskingInterface* tasking) 
+  {
+    Device* device = (Device*) hdevice;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeviceSetTaskingInterface);
+    RTCORE_VERIFY_HANDLE(hdevice);
+    device->setTaskingInterface(tasking);
+    RTCORE_CATCH_END(device);
+  }
+
   RTCORE_API void rtcDebug() 
   {
     RTCORE_CATCH_BEGIN;
@@ -225,6 +235,36 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
   
+  RTCORE_API void rtcSetMemoryBudget(RTCScene hscene, size_t bytes) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetMemoryBudget);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->setMemoryBudget(bytes);
+    RTCORE_CATCH_END(scene->device);
+  }
+  
+  RTCORE_API void rtcSetTessellationCacheSize(RTCScene hscene, size_t bytes) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetTessellationCacheSize);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->setTessellationCacheSize(bytes);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcGetTessellationCacheStatistics(RTCScene hscene, RTCTessellationCacheStatistics& stats_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetTessellationCacheStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->getTessellationCacheStatistics(stats_o);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcCommit (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
@@ -258,6 +298,28 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSaveBVH(RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSaveBVH);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_HANDLE(filename);
+    scene->save(filename);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcLoadBVH(RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcLoadBVH);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_HANDLE(filename);
+    scene->load(filename);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcGetBounds(RTCScene hscene, RTCBounds& bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -303,6 +365,40 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
   
+  RTCORE_API size_t rtcGetNumAccels(RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetNumAccels);
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    return scene->getNumAccels();
+    RTCORE_CATCH_END(scene->device);
+    return 0;
+  }
+
+  RTCORE_API void rtcGetMemoryStatistics(RTCScene hscene, RTCMemoryStatistics& stats_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetMemoryStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    scene->getMemoryStatistics(stats_o);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcGetAccelMemoryStatistics(RTCScene hscene, size_t accelID, RTCMemoryStatistics& stats_o)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcGetAccelMemoryStatistics);
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    scene->getAccelMemoryStatistics(accelID,stats_o);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcIntersect (RTCScene hscene, RTCRay& ray) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1014,7 +1110,21 @@ namespace embree
     RTCORE_TRACE(rtcSetBuffer);
     RTCORE_VERIFY_HANDLE(hscene);
     RTCORE_VERIFY_GEOMID(geomID);
-    scene->get_locked(geomID)->setBuffer(type,(void*)ptr,offset,stride);
+    Geometry* geometry = scene->get_locked(geomID);
+    geometry->setBuffer(type,(void*)ptr,offset,stride);
+    geometry->unmapFileBuffer(type);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcSetFileBuffer(RTCScene hscene, unsigned geomID, RTCBufferType type, const char* fileName, size_t offset, size_t stride, size_t num)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetFileBuffer);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    RTCORE_VERIFY_HANDLE(fileName);
+    scene->get_locked(geomID)->setFileBuffer(type,fileName,offset,stride,num);
     RTCORE_CATCH_END(scene->device);
   }
 
@@ -116,6 +116,26 @@ namespace embree
     return rtcCommitThread(scene,threadID,numThreads);
   }
 
+  extern "C" void ispcSetMemoryBudget (RTCScene scene, size_t bytes) {
+    rtcSetMemoryBudget(scene,bytes);
+  }
+
+  extern "C" void ispcSetTessellationCacheSize (RTCScene scene, size_t bytes) {
+    rtcSetTessellationCacheSize(scene,bytes);
+  }
+
+  extern "C" void ispcGetTessellationCacheStatistics(RTCScene scene, RTCTessellationCacheStatistics& stats_o) {
+    rtcGetTessellationCacheStatistics(scene,stats_o);
+  }
+
+  extern "C" void ispcSaveBVH (RTCScene scene, const char* filename) {
+    return rtcSaveBVH(scene,filename);
+  }
+
+  extern "C" void ispcLoadBVH (RTCScene scene, const char* filename) {
+    return rtcLoadBVH(scene,filename);
+  }
+
   extern "C" void ispcGetBounds(RTCScene scene, RTCBounds& bounds_o) {
     rtcGetBounds(scene,bounds_o);
   }
@@ -123,6 +143,18 @@ namespace embree
   extern "C" void ispcGetLinearBounds(RTCScene scene, RTCBounds* bounds_o) {
     rtcGetLinearBounds(scene,bounds_o);
   }
+
+  extern "C" size_t ispcGetNumAccels(RTCScene scene) {
+    return rtcGetNumAccels(scene);
+  }
+
+  extern "C" void ispcGetMemoryStatistics(RTCScene scene, RTCMemoryStatistics& stats_o) {
+    rtcGetMemoryStatistics(scene,stats_o);
+  }
+
+  extern "C" void ispcGetAccelMemoryStatistics(RTCScene scene, size_t accelID, RTCMemoryStatistics& stats_o) {
+    rtcGetAccelMemoryStatistics(scene,accelID,stats_o);
+  }
   
   extern "C" void ispcIntersect1 (RTCScene scene, RTCRay& ray) {
     rtcIntersect(scene,ray);
@@ -270,6 +302,10 @@ namespace embree
     rtcSetBuffer(scene,geomID,type,ptr,offset,stride);
   }
 
+  extern "C" void ispcSetFileBuffer(RTCScene scene, unsigned geomID, RTCBufferType type, const char* fileName, size_t offset, size_t stride, size_t num) {
+    rtcSetFileBuffer(scene,geomID,type,fileName,offset,stride,num);
+  }
+
   extern "C" void ispcEnable (RTCScene scene, unsigned geomID) {
     rtcEnable(scene,geomID);
   }
@@ -0,0 +1,169 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "sah_calibration.h"
+#include "state.h"
+#include "version.h"
+#include "../../common/math/vec3.h"
+#include <fstream>
+
+namespace embree
+{
+  /*! name that identifies the CPU model, on ARM the implementer and
+   *  part numbers are used as all cores report the same CPUModel */
+  static std::string getCPUModelName()
+  {
+    std::string name;
+#if defined(__LINUX__)
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo,line))
+    {
+      const size_t pos = line.find(':');
+      if (pos == std::string::npos) continue;
+      const std::string key = line.substr(0,line.find_last_not_of(" \t",pos-1)+1);
+      if (key != "model name" && key != "CPU implementer" && key != "CPU part") continue;
+      name += line.substr(pos+1);
+      if (key != "CPU implementer") break;
+    }
+#endif
+    if (name == "") 
+      name = getCPUVendor() + stringOfCPUModel(getCPUModel());
+
+    /* make name usable as part of a filename */
+    std::string key;
+    for (size_t i=0; i<name.size(); i++) {
+      const char c = name[i];
+      if (isalnum(c)) key += c;
+      else if (key.size() && key[key.size()-1] != '_') key += '_';
+    }
+    while (key.size() && key[key.size()-1] == '_') key.resize(key.size()-1);
+    return key;
+  }
+
+  /*! generates deterministic pseudo random numbers in [0,1) */
+  struct CalibrationRandom
+  {
+    CalibrationRandom () : state(0x12345678) {}
+    __forceinline float get() { state = state*1103515245 + 12345; return float((state >> 8) & 0xFFFF)/65536.0f; }
+    __forceinline vfloat4 get4() { const float a = get(), b = get(), c = get(), d = get(); return vfloat4(a,b,c,d); }
+    unsigned int state;
+  };
+
+  /*! measures time to intersect a ray with the 4 boxes of a node including the child push loop */
+  static __noinline double measureNodeIntersections(size_t N, size_t& hits)
+  {
+    CalibrationRandom rng;
+    const Vec3vf4 lower(rng.get4(),rng.get4(),rng.get4());
+    const Vec3vf4 upper = lower + Vec3vf4(vfloat4(0.5f));
+    Vec3vf4 org(vfloat4(-1.0f)); 
+    const Vec3vf4 rdir(vfloat4(rcp(0.7f)),vfloat4(rcp(0.8f)),vfloat4(rcp(0.9f)));
+    const vfloat4 tnear(0.0f), tfar(inf);
+
+    const double t0 = getSeconds();
+    for (size_t i=0; i<N; i++)
+    {
+      const vfloat4 tLowerX = (lower.x - org.x) * rdir.x;
+      const vfloat4 tLowerY = (lower.y - org.y) * rdir.y;
+      const vfloat4 tLowerZ = (lower.z - org.z) * rdir.z;
+      const vfloat4 tUpperX = (upper.x - org.x) * rdir.x;
+      const vfloat4 tUpperY = (upper.y - org.y) * rdir.y;
+      const vfloat4 tUpperZ = (upper.z - org.z) * rdir.z;
+      const vfloat4 tNear = max(min(tLowerX,tUpperX),min(tLowerY,tUpperY),min(tLowerZ,tUpperZ),tnear);
+      const vfloat4 tFar  = min(max(tLowerX,tUpperX),max(tLowerY,tUpperY),max(tLowerZ,tUpperZ),tfar);
+      size_t mask = movemask(tNear <= tFar);
+      while (mask) { __bscf(mask); hits++; }
+      org.x += vfloat4(1E-6f); /* prevents hoisting out of the loop */
+    }
+    return getSeconds()-t0;
+  }
+
+  /*! measures time to intersect a ray with 4 triangles using the Moeller Trumbore test of the Triangle4 intersector */
+  static __noinline double measureTriangleIntersections(size_t N, size_t& hits)
+  {
+    CalibrationRandom rng;
+    const Vec3vf4 v0(rng.get4(),rng.get4(),rng.get4());
+    const Vec3vf4 v1(rng.get4(),rng.get4(),rng.get4());
+    const Vec3vf4 v2(rng.get4(),rng.get4(),rng.get4());
+    const Vec3vf4 e1 = v0-v1, e2 = v2-v0, Ng = cross(e1,e2);
+    Vec3vf4 org(vfloat4(0.3f),vfloat4(0.3f),vfloat4(-1.0f)); 
+    const Vec3vf4 dir(vfloat4(0.0f),vfloat4(0.0f),vfloat4(1.0f));
+    const vfloat4 tnear(0.0f), tfar(inf);
+
+    const double t0 = getSeconds();
+    for (size_t i=0; i<N; i++)
+    {
+      const Vec3vf4 C = v0 - org;
+      const Vec3vf4 R = cross(dir,C);
+      const vfloat4 den = dot(Ng,dir);
+      const vfloat4 absDen = abs(den);
+      const vfloat4 sgnDen = signmsk(den);
+      const vfloat4 U = dot(R,e2) ^ sgnDen;
+      const vfloat4 V = dot(R,e1) ^ sgnDen;
+      vbool4 valid = (den != vfloat4(zero)) & (U >= 0.0f) & (V >= 0.0f) & (U+V <= absDen);
+      const vfloat4 T = dot(Ng,C) ^ sgnDen;
+      valid &= (T > absDen*tnear) & (T < absDen*tfar);
+      size_t mask = movemask(valid);
+      while (mask) { __bscf(mask); hits++; }
+      org.x += vfloat4(1E-6f); /* prevents hoisting out of the loop */
+    }
+    return getSeconds()-t0;
+  }
+
+  void calibrateSAHCosts(State* state)
+  {
+    const std::string cpu = getCPUModelName();
+    const FileName home = FileName::homeFolder();
+    const FileName cacheFile = home != FileName("") ? home+FileName(".embree" TOSTRING(__EMBREE_VERSION_MAJOR__) "_sah_" + cpu) : FileName("");
+
+    /* use cached calibration for this CPU model if available */
+    if (cacheFile != FileName("") && state->parseFile(cacheFile)) 
+    {
+      if (state->verbosity(1)) 
+        std::cout << "using SAH costs from " << cacheFile << ": sah_trav_cost = " << state->sah_trav_cost << ", sah_int_cost = " << state->sah_int_cost << std::endl;
+      return;
+    }
+
+    /* take the best out of a few runs to filter out interruptions */
+    const size_t N = 1024*1024;
+    size_t hits = 0;
+    double tNode = inf, tTri = inf;
+    for (size_t i=0; i<5; i++) {
+      tNode = min(tNode,measureNodeIntersections(N,hits));
+      tTri  = min(tTri ,measureTriangleIntersections(N,hits));
+    }
+
+    /* costs are relative to a node traversal step */
+    state->sah_trav_cost = 1.0f;
+    state->sah_int_cost = clamp(float(tTri/tNode),0.25f,4.0f);
+
+    if (state->verbosity(1)) {
+      std::cout << "calibrated SAH costs for " << cpu << " (" << hits << " hits): " 
+                << "node = " << 1E9*tNode/double(N) << " ns, triangles = " << 1E9*tTri/double(N) << " ns" << std::endl;
+      std::cout << "  sah_trav_cost = " << state->sah_trav_cost << ", sah_int_cost = " << state->sah_int_cost << std::endl;
+    }
+
+    /* store calibration in configuration syntax */
+    if (cacheFile != FileName(""))
+    {
+      std::ofstream file(cacheFile.c_str());
+      if (!file.is_open()) return;
+      file << "# SAH costs calibrated for " << cpu << std::endl;
+      file << "sah_trav_cost=" << state->sah_trav_cost << std::endl;
+      file << "sah_int_cost=" << state->sah_int_cost << std::endl;
+    }
+  }
+}
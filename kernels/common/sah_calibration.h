@@ -0,0 +1,32 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  struct State;
+
+  /*! Measures the cost of intersecting a ray with a 4-wide node
+   *  relative to intersecting a ray with a block of 4 triangles and
+   *  stores the result as sah_trav_cost and sah_int_cost in the
+   *  state. Results are cached per CPU model in the home folder in
+   *  the same syntax as the configuration string, thus a cached file
+   *  can also get passed to other machines of the same type. */
+  void calibrateSAHCosts(State* state);
+}
@@ -18,6 +18,12 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh_serializer.h"
+#include "../subdiv/tessellation_cache.h"
+#include "primref.h"
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
  
 namespace embree
 {
@@ -42,6 +48,7 @@ namespace embree
       needLineIndices(false), needLineVertices(false),
       needSubdivIndices(false), needSubdivVertices(false),
       is_build(false), modified(true),
+      memoryBudget(0), triangleAccelID(-1), triangleCompaction(TRI_DEFAULT), triangleEstimateScale(1.0f),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
       numIntersectionFilters1(0), numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0), numIntersectionFiltersN(0)
   {
@@ -93,56 +100,68 @@ namespace embree
 
   void Scene::createTriangleAccel()
   {
+#if defined(EMBREE_GEOMETRY_TRIANGLES)
+    triangleAccelID = accels.accels.size();
+    accels.add(createTriangleAccel(triangleCompaction));
+#endif
+  }
+
+  Accel* Scene::createTriangleAccel(TriangleCompaction compaction)
+  {
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
     if (device->tri_accel == "default") 
     {
+      const bool compact = isCompact() || compaction >= TRI_INDEXED;
+      const bool quantized = isCompact() || compaction >= TRI_QUANTIZED;
+      const bool highQuality = isHighQuality() && compaction == TRI_DEFAULT;
       if (isStatic()) {
-        int mode =  2*(int)isCompact() + 1*(int)isRobust(); 
+        int mode =  2*(int)compact + 1*(int)isRobust(); 
         switch (mode) {
         case /*0b00*/ 0: 
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX))
 	  {
-            if (isHighQuality()) 
-              accels.add(device->bvh8_factory->BVH8Triangle4(this,BVH8Factory::BuildVariant::HIGH_QUALITY,BVH8Factory::IntersectVariant::FAST)); 
+            if (highQuality) 
+              return device->bvh8_factory->BVH8Triangle4(this,BVH8Factory::BuildVariant::HIGH_QUALITY,BVH8Factory::IntersectVariant::FAST); 
             else
-              accels.add(device->bvh8_factory->BVH8Triangle4(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::FAST));
+              return device->bvh8_factory->BVH8Triangle4(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::FAST);
           }
           else 
 #endif
           { 
-            if (isHighQuality()) 
-              accels.add(device->bvh4_factory->BVH4Triangle4(this,BVH4Factory::BuildVariant::HIGH_QUALITY,BVH4Factory::IntersectVariant::FAST));
+            if (highQuality) 
+              return device->bvh4_factory->BVH4Triangle4(this,BVH4Factory::BuildVariant::HIGH_QUALITY,BVH4Factory::IntersectVariant::FAST);
             else 
-              accels.add(device->bvh4_factory->BVH4Triangle4(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST));
+              return device->bvh4_factory->BVH4Triangle4(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST);
           }
-          break;
 
         case /*0b01*/ 1: 
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX)) 
-            accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::ROBUST)); 
+            return device->bvh8_factory->BVH8Triangle4v(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::ROBUST); 
           else
 #endif
-            accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); 
+            return device->bvh4_factory->BVH4Triangle4v(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST); 
 
-          break;
         case /*0b10*/ 2: 
+          if (quantized && device->hasISA(CPU_FEATURE_FP16))
+            return device->bvh4_factory->BVH4HalfTriangle4i(this);
+          else if (quantized)
+            return device->bvh4_factory->BVH4QuantizedTriangle4i(this);
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX)) 
-            accels.add(device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::FAST  )); 
+            return device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::FAST  ); 
           else
 #endif
-            accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  )); 
-          break;
+            return device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  ); 
+
         case /*0b11*/ 3: 
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX)) 
-            accels.add(device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::ROBUST)); 
+            return device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::ROBUST); 
           else
 #endif
-            accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); 
-          break;
+            return device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST); 
         }
       }
       else /* dynamic */
@@ -150,39 +169,41 @@ namespace embree
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX))
 	  {
-            int mode =  2*(int)isCompact() + 1*(int)isRobust();
+            int mode =  2*(int)compact + 1*(int)isRobust();
             switch (mode) {
-            case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8Triangle4 (this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::FAST  )); break;
-            case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8Triangle4v(this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::ROBUST)); break; 
-            case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::FAST  )); break;
-            case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::ROBUST)); break;
+            case /*0b00*/ 0: return device->bvh8_factory->BVH8Triangle4 (this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::FAST  );
+            case /*0b01*/ 1: return device->bvh8_factory->BVH8Triangle4v(this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::ROBUST);
+            case /*0b10*/ 2: return device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::FAST  );
+            case /*0b11*/ 3: return device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::DYNAMIC,BVH8Factory::IntersectVariant::ROBUST);
             }
           }
           else
 #endif
           {
-            int mode =  2*(int)isCompact() + 1*(int)isRobust();
+            int mode =  2*(int)compact + 1*(int)isRobust();
             switch (mode) {
-            case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4Triangle4 (this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::FAST  )); break;
-            case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4v(this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::ROBUST)); break;
-            case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::FAST  )); break;
-            case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::ROBUST)); break;
+            case /*0b00*/ 0: return device->bvh4_factory->BVH4Triangle4 (this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::FAST  );
+            case /*0b01*/ 1: return device->bvh4_factory->BVH4Triangle4v(this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::ROBUST);
+            case /*0b10*/ 2: return device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::FAST  );
+            case /*0b11*/ 3: return device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::DYNAMIC,BVH4Factory::IntersectVariant::ROBUST);
             }
           }
       }
     }
-    else if (device->tri_accel == "bvh4.triangle4")       accels.add(device->bvh4_factory->BVH4Triangle4 (this));
-    else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
-    else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
-    else if (device->tri_accel == "qbvh4.triangle4i")     accels.add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4")       return device->bvh4_factory->BVH4Triangle4 (this);
+    else if (device->tri_accel == "bvh4.triangle4v")      return device->bvh4_factory->BVH4Triangle4v(this);
+    else if (device->tri_accel == "bvh4.triangle4i")      return device->bvh4_factory->BVH4Triangle4i(this);
+    else if (device->tri_accel == "qbvh4.triangle4i")     return device->bvh4_factory->BVH4QuantizedTriangle4i(this);
+    else if (device->tri_accel == "hbvh4.triangle4i")     return device->bvh4_factory->BVH4HalfTriangle4i(this);
 
 #if defined (__TARGET_AVX__)
-    else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4 (this));
-    else if (device->tri_accel == "bvh8.triangle4i")      accels.add(device->bvh8_factory->BVH8Triangle4i(this));
-    else if (device->tri_accel == "qbvh8.triangle4i")     accels.add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh8.triangle4")       return device->bvh8_factory->BVH8Triangle4 (this);
+    else if (device->tri_accel == "bvh8.triangle4i")      return device->bvh8_factory->BVH8Triangle4i(this);
+    else if (device->tri_accel == "qbvh8.triangle4i")     return device->bvh8_factory->BVH8QuantizedTriangle4i(this);
 #endif
-    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
+    throw_RTCError(RTC_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
+    return nullptr;
   }
 
   void Scene::createTriangleMBAccel()
@@ -261,7 +282,12 @@ namespace embree
             accels.add(device->bvh4_factory->BVH4Quad4v(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST));
           break;
 
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST)); break;
+        case /*0b10*/ 2:
+          if (device->hasISA(CPU_FEATURE_FP16))
+            accels.add(device->bvh4_factory->BVH4HalfQuad4i(this));
+          else
+            accels.add(device->bvh4_factory->BVH4QuantizedQuad4i(this));
+          break;
         case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -278,6 +304,7 @@ namespace embree
     else if (device->quad_accel == "bvh4.quad4v")       accels.add(device->bvh4_factory->BVH4Quad4v(this));
     else if (device->quad_accel == "bvh4.quad4i")       accels.add(device->bvh4_factory->BVH4Quad4i(this));
     else if (device->quad_accel == "qbvh4.quad4i")      accels.add(device->bvh4_factory->BVH4QuantizedQuad4i(this));
+    else if (device->quad_accel == "hbvh4.quad4i")      accels.add(device->bvh4_factory->BVH4HalfQuad4i(this));
 
 #if defined (__TARGET_AVX__)
     else if (device->quad_accel == "bvh8.quad4v")       accels.add(device->bvh8_factory->BVH8Quad4v(this));
@@ -696,15 +723,40 @@ namespace embree
   {
     progress_monitor_counter = 0;
 
+    /* select triangle layout that is expected to fit into the memory budget, stored hierarchies have a fixed layout */
+    if (memoryBudget && loadBVHFile == "")
+      selectTriangleCompaction();
+
     /* select fast code path if no intersection filter is present */
     accels.select(numIntersectionFiltersN+numIntersectionFilters4,
                   numIntersectionFiltersN+numIntersectionFilters8,
                   numIntersectionFiltersN+numIntersectionFilters16,
                   numIntersectionFiltersN);
   
+    /* load all hierarchies of this scene from file, builders are not required anymore in that case */
+    const bool loaded = loadBVHFile != "" && loadBVH(this,loadBVHFile);
+    if (loaded) accels.immutable();
+
     /* build all hierarchies of this scene */
     accels.build(0,0);
 
+    /* rebuild triangles more compactly as long as the memory budget is exceeded */
+    while (memoryBudget && !loaded && exceedsMemoryBudget()) 
+    {
+      if (!compactTriangleAccel()) 
+        throw_RTCError(RTC_OUT_OF_MEMORY,"scene exceeds its memory budget");
+
+      accels.select(numIntersectionFiltersN+numIntersectionFilters4,
+                    numIntersectionFiltersN+numIntersectionFilters8,
+                    numIntersectionFiltersN+numIntersectionFilters16,
+                    numIntersectionFiltersN);
+      accels.rebuild(triangleAccelID);
+    }
+
+    /* store hierarchies before geometry buffers get released */
+    if (saveBVHFile != "")
+      saveBVH(this,saveBVHFile);
+
     /* make static geometry immutable */
     if (isStatic()) 
     {
@@ -719,6 +771,7 @@ namespace embree
       Geometry* geom = geometries[i];
       if (!geom) continue;
       if (geom->isEnabled()) geom->clearModified(); // FIXME: should builders do this?
+      geom->adviseFileBuffers(false); // rendering accesses file mapped buffers randomly
     }
 
     updateInterface();
@@ -733,10 +786,211 @@ namespace embree
     setModified(false);
   }
 
+  void Scene::setTessellationCacheSize (size_t bytes)
+  {
+    if (bytes >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
+      bytes = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
+
+    if (bytes == 0) {
+      tessellationCache.reset();
+    }
+    else 
+    {
+      if (!tessellationCache) tessellationCache.reset(new SharedLazyTessellationCache);
+      if (tessellationCache->getSize() != bytes) tessellationCache->realloc(bytes);
+    }
+  }
+
+  void Scene::getTessellationCacheStatistics (RTCTessellationCacheStatistics& stats_o)
+  {
+    SharedLazyTessellationCache::Statistics stats;
+    memset(&stats,0,sizeof(stats));
+    if (tessellationCache) tessellationCache->getStatistics(stats);
+    else SharedLazyTessellationCache::getSharedStatistics(stats);
+
+    stats_o.hits           = stats.hits;
+    stats_o.misses         = stats.misses;
+    stats_o.flushes        = stats.flushes;
+    stats_o.bytes          = stats.bytes;
+    stats_o.allocatedBytes = stats.allocatedBytes;
+  }
+
 #if defined(TASKING_INTERNAL)
 
+  void Scene::save (const std::string& fileName)
+  {
+    if (!isStatic())
+      throw_RTCError(RTC_INVALID_OPERATION,"BVH files are only supported for static scenes");
+    if (!isModified())
+      throw_RTCError(RTC_INVALID_OPERATION,"scene got already committed");
+
+    saveBVHFile = fileName;
+    try { build(0,0); } 
+    catch (...) { saveBVHFile = ""; throw; }
+    saveBVHFile = "";
+  }
+
+  void Scene::load (const std::string& fileName)
+  {
+    if (!isStatic())
+      throw_RTCError(RTC_INVALID_OPERATION,"BVH files are only supported for static scenes");
+
+    loadBVHFile = fileName;
+    try { build(0,0); } 
+    catch (...) { loadBVHFile = ""; throw; }
+    loadBVHFile = "";
+  }
+
+  void Scene::getMemoryStatistics (RTCMemoryStatistics& stats)
+  {
+    memset(&stats,0,sizeof(stats));
+    for (size_t i=0; i<accels.accels.size(); i++)
+      accels.accels[i]->addMemoryStatistics(stats);
+
+    /* the device wide tessellation cache is shared by all scenes with subdivision meshes */
+    if (world.numSubdivPatches || worldMB.numSubdivPatches) 
+    {
+      SharedLazyTessellationCache::Statistics cacheStats;
+      memset(&cacheStats,0,sizeof(cacheStats));
+      if (tessellationCache) tessellationCache->getStatistics(cacheStats);
+      else SharedLazyTessellationCache::getSharedStatistics(cacheStats);
+      stats.tessellationCache = cacheStats.bytes;
+    }
+
+    for (size_t i=0; i<geometries.size(); i++) 
+      if (geometries[i] && geometries[i]->type == Geometry::SUBDIV_MESH)
+        stats.halfEdges += ((SubdivMesh*)geometries[i])->getHalfEdgeBytes();
+
+    stats.total = stats.innerNodes + stats.leaves + stats.primRefs + stats.tessellationCache + stats.halfEdges + stats.wasted + stats.free;
+  }
+
+  void Scene::getAccelMemoryStatistics (size_t accelID, RTCMemoryStatistics& stats)
+  {
+    if (accelID >= accels.accels.size())
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid acceleration structure ID");
+
+    memset(&stats,0,sizeof(stats));
+    stats.name = accels.accels[accelID]->getName();
+    accels.accels[accelID]->addMemoryStatistics(stats);
+    stats.total = stats.innerNodes + stats.leaves + stats.primRefs + stats.wasted + stats.free;
+  }
+
+  void Scene::setMemoryBudget (size_t bytes)
+  {
+    if (isStatic() && isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    memoryBudget = bytes;
+    setModified();
+  }
+
+  Scene::TriangleCompaction Scene::maxTriangleCompaction() const
+  {
+    if (device->tri_accel != "default" || triangleAccelID >= accels.accels.size()) return TRI_DEFAULT;
+    if (isStatic() && !isRobust()) return TRI_QUANTIZED;
+    return TRI_INDEXED;
+  }
+
+  size_t Scene::estimateTriangleAccelBytes(TriangleCompaction compaction) const
+  {
+    const bool indexed = isCompact() || compaction >= TRI_INDEXED;
+    const bool quantized = indexed && isStatic() && !isRobust() && (isCompact() || compaction >= TRI_QUANTIZED);
+    const bool splits = isStatic() && isHighQuality() && compaction == TRI_DEFAULT;
+    size_t N = 4;
+#if defined (__TARGET_AVX__)
+    if (device->hasISA(AVX) && !quantized) N = 8;
+#endif
+    const size_t primBytes = indexed ? sizeof(Triangle4i) : isRobust() ? sizeof(Triangle4v) : sizeof(Triangle4);
+    size_t nodeBytes = N*(sizeof(size_t)+6*sizeof(float));
+    if (quantized) nodeBytes = device->hasISA(CPU_FEATURE_FP16) ? N*(sizeof(size_t)+6*2)+3*sizeof(float) : N*(sizeof(size_t)+6)+6*sizeof(float);
+
+    /* spatial splits add about 20% references, SAH leaves hold about two triangles in one primitive block */
+    const double numRefs = (splits ? 1.2 : 1.0)*double(world.numTriangles);
+    const double numLeaves = 0.5*numRefs;
+    const double numNodes = numLeaves/double(N-1);
+    return size_t(numLeaves*primBytes + numNodes*nodeBytes + numRefs*sizeof(PrimRef));
+  }
+
+  void Scene::setTriangleCompaction(TriangleCompaction compaction)
+  {
+    if (compaction == triangleCompaction) return;
+    accels.replace(triangleAccelID,createTriangleAccel(compaction));
+    triangleCompaction = compaction;
+  }
+
+  void Scene::selectTriangleCompaction()
+  {
+    const TriangleCompaction maxCompaction = maxTriangleCompaction();
+    if (maxCompaction == TRI_DEFAULT) return;
+
+    /* memory of the other acceleration structures from their last build */
+    RTCMemoryStatistics sceneStats, triStats;
+    getMemoryStatistics(sceneStats);
+    getAccelMemoryStatistics(triangleAccelID,triStats);
+    const size_t otherBytes = sceneStats.total - sceneStats.tessellationCache - triStats.total;
+
+    int compaction = TRI_DEFAULT;
+    for (; compaction<maxCompaction; compaction++) {
+      const size_t bytes = size_t(triangleEstimateScale*estimateTriangleAccelBytes((TriangleCompaction)compaction));
+      if (otherBytes + bytes <= memoryBudget) break;
+    }
+    setTriangleCompaction((TriangleCompaction)compaction);
+  }
+
+  bool Scene::compactTriangleAccel()
+  {
+    /* skip levels that are equivalent for the flags of this scene */
+    const TriangleCompaction maxCompaction = maxTriangleCompaction();
+    const size_t bytes = estimateTriangleAccelBytes(triangleCompaction);
+    for (int compaction = triangleCompaction+1; compaction <= maxCompaction; compaction++) {
+      if (compaction < maxCompaction && estimateTriangleAccelBytes((TriangleCompaction)compaction) >= bytes) continue;
+      setTriangleCompaction((TriangleCompaction)compaction);
+      return true;
+    }
+    return false;
+  }
+
+  bool Scene::exceedsMemoryBudget()
+  {
+    /* the tessellation cache is shared with other scenes and not part of the budget */
+    RTCMemoryStatistics stats;
+    getMemoryStatistics(stats);
+    const size_t bytes = stats.total - stats.tessellationCache;
+
+    /* calibrate the estimate of the next triangle compaction selection */
+    if (maxTriangleCompaction() != TRI_DEFAULT && world.numTriangles) 
+    {
+      RTCMemoryStatistics triStats;
+      getAccelMemoryStatistics(triangleAccelID,triStats);
+      const size_t estimate = estimateTriangleAccelBytes(triangleCompaction);
+      if (estimate) triangleEstimateScale = float(double(triStats.total)/double(estimate));
+    }
+
+    if (bytes <= memoryBudget) return false;
+    if (device->verbosity(1))
+      std::cout << "scene uses " << bytes << " bytes, exceeding its memory budget of " << memoryBudget << " bytes" << std::endl;
+    return true;
+  }
+
   void Scene::build (size_t threadIndex, size_t threadCount) 
   {
+    /* the host tasking system executes all parallel work of the build, joining threads wait for it to finish */
+    if (TaskScheduler::host()) 
+    {
+      Lock<MutexSys> lock(buildMutex);
+      if (!isModified()) return;
+      if (!ready()) throw_RTCError(RTC_INVALID_OPERATION,"not all buffers are unmapped");
+      try {
+        build_task();
+      }
+      catch (...) {
+        accels.clear();
+        updateInterface();
+        throw;
+      }
+      return;
+    }
+
     Lock<MutexSys> buildLock(buildMutex,false);
 
     /* allocates own taskscheduler for each build */
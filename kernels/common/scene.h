@@ -98,12 +98,24 @@ namespace embree
       bool all;
       };
 
+  public:
+
+    /*! compaction levels of the default triangle acceleration structure, from fastest to smallest */
+    enum TriangleCompaction 
+    {
+      TRI_DEFAULT   = 0,  //!< layout selected by the scene flags
+      TRI_NO_SPLITS = 1,  //!< no spatial splits for high quality scenes
+      TRI_INDEXED   = 2,  //!< triangles referenced by index as in compact mode
+      TRI_QUANTIZED = 3   //!< indexed triangles below 8 bit quantized (half precision with FP16 support) nodes, static non-robust scenes only
+    };
+    
   public:
     
     /*! Scene construction */
     Scene (Device* device, RTCSceneFlags flags, RTCAlgorithmFlags aflags);
 
     void createTriangleAccel();
+    Accel* createTriangleAccel(TriangleCompaction compaction);
     void createQuadAccel();
     void createTriangleMBAccel();
     void createQuadMBAccel();
@@ -153,6 +165,59 @@ namespace embree
     void build (size_t threadIndex, size_t threadCount);
     void build_task ();
 
+    /*! Builds the static scene and stores all hierarchies to a file. */
+    void save (const std::string& fileName);
+
+    /*! Commits the static scene by loading all hierarchies from a file. */
+    void load (const std::string& fileName);
+
+    /*! returns the number of acceleration structures of the scene */
+    size_t getNumAccels() const { return accels.accels.size(); }
+
+    /*! returns the memory consumption of the entire scene */
+    void getMemoryStatistics (RTCMemoryStatistics& stats);
+
+    /*! returns the memory consumption of some acceleration structure of the scene */
+    void getAccelMemoryStatistics (size_t accelID, RTCMemoryStatistics& stats);
+
+    /*! sets the memory budget of the scene, 0 disables the budget */
+    void setMemoryBudget (size_t bytes);
+
+    /*! gives the scene its own tessellation cache of the specified size, 0 uses the device wide cache */
+    void setTessellationCacheSize (size_t bytes);
+
+    /*! returns the statistics of the tessellation cache used by the scene */
+    void getTessellationCacheStatistics (RTCTessellationCacheStatistics& stats);
+
+    /*! returns the tessellation cache to use by the calling thread */
+    __forceinline SharedLazyTessellationCache& getTessellationCache() 
+    {
+      if (tessellationCache) return *tessellationCache;
+      return SharedLazyTessellationCache::sharedCache();
+    }
+
+  private:
+
+    /*! most compact layout the default triangle acceleration structure supports for this scene */
+    TriangleCompaction maxTriangleCompaction() const;
+
+    /*! rough estimate of the peak bytes to build the default triangle acceleration structure */
+    size_t estimateTriangleAccelBytes(TriangleCompaction compaction) const;
+
+    /*! replaces the triangle acceleration structure by one of the given compaction */
+    void setTriangleCompaction(TriangleCompaction compaction);
+
+    /*! selects the least compact triangle layout estimated to fit into the memory budget */
+    void selectTriangleCompaction();
+
+    /*! switches to the next smaller triangle layout, returns false if there is none */
+    bool compactTriangleAccel();
+
+    /*! returns true if the built scene exceeds its memory budget */
+    bool exceedsMemoryBudget();
+
+  public:
+
     void updateInterface();
 
     /* return number of geometries */
@@ -317,6 +382,13 @@ namespace embree
     SpinLock geometriesMutex;
     bool is_build;
     bool modified;                   //!< true if scene got modified
+    std::string saveBVHFile;         //!< file to store hierarchies to during next build
+    std::string loadBVHFile;         //!< file to load hierarchies from during next build
+    size_t memoryBudget;             //!< maximal bytes of the hierarchies and their build data, 0 for no budget
+    std::unique_ptr<SharedLazyTessellationCache> tessellationCache; //!< tessellation cache of this scene, null for the device wide cache
+    size_t triangleAccelID;          //!< index of the triangle acceleration structure in accels
+    TriangleCompaction triangleCompaction; //!< compaction level of the triangle acceleration structure
+    float triangleEstimateScale;     //!< ratio of measured and estimated triangle memory of the last build
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL) 
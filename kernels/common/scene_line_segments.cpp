@@ -89,6 +89,19 @@ namespace embree
       }
     }
   }
+  size_t LineSegments::getBufferSize(RTCBufferType type) const
+  {
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) 
+      return numVertices();
+
+    switch (type) {
+    case RTC_INDEX_BUFFER       : return segments.size();
+    case RTC_USER_VERTEX_BUFFER0: 
+    case RTC_USER_VERTEX_BUFFER1: return numVertices();
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return 0;
+    }
+  }
+
 
   void* LineSegments::map(RTCBufferType type)
   {
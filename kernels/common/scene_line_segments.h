@@ -39,6 +39,7 @@ namespace embree
     void disabling();
     void setMask (unsigned mask);
     void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    size_t getBufferSize(RTCBufferType type) const;
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
     void immutable ();
@@ -90,6 +90,19 @@ namespace embree
       }
     }
   }
+  size_t QuadMesh::getBufferSize(RTCBufferType type) const
+  {
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) 
+      return numVertices();
+
+    switch (type) {
+    case RTC_INDEX_BUFFER       : return quads.size();
+    case RTC_USER_VERTEX_BUFFER0: 
+    case RTC_USER_VERTEX_BUFFER1: return numVertices();
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return 0;
+    }
+  }
+
 
   void* QuadMesh::map(RTCBufferType type) 
   {
@@ -137,6 +137,34 @@ namespace embree
       }
     }
   }
+  size_t SubdivMesh::getBufferSize(RTCBufferType type) const
+  {
+    if (type >= RTC_VERTEX_BUFFER0 && type < RTCBufferType(RTC_VERTEX_BUFFER0 + numTimeSteps)) 
+      return numVertices;
+
+    switch (type) {
+    case RTC_INDEX_BUFFER               : return vertexIndices.size();
+    case RTC_FACE_BUFFER                : return faceVertices.size();
+    case RTC_HOLE_BUFFER                : return holes.size();
+    case RTC_EDGE_CREASE_INDEX_BUFFER   : return edge_creases.size();
+    case RTC_EDGE_CREASE_WEIGHT_BUFFER  : return edge_crease_weights.size();
+    case RTC_VERTEX_CREASE_INDEX_BUFFER : return vertex_creases.size();
+    case RTC_VERTEX_CREASE_WEIGHT_BUFFER: return vertex_crease_weights.size();
+    case RTC_LEVEL_BUFFER               : return levels.size();
+    case RTC_USER_VERTEX_BUFFER0: 
+    case RTC_USER_VERTEX_BUFFER1: return numVertices;
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return 0;
+    }
+  }
+
+  size_t SubdivMesh::getHalfEdgeBytes() const
+  {
+    return faceStartEdge.capacity()*sizeof(uint32_t) +
+      halfEdges.capacity()*sizeof(HalfEdge) +
+      invalid_face.capacity()*sizeof(char) +
+      halfEdges0.capacity()*sizeof(KeyHalfEdge) +
+      halfEdges1.capacity()*sizeof(KeyHalfEdge);
+  }
 
   void* SubdivMesh::map(RTCBufferType type) 
   {
@@ -612,7 +640,7 @@ namespace embree
     for (size_t i=0; i<numFloats; i+=4)
     {
       vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;
-      isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),parent->commitCounterSubdiv,
+      isa::PatchEval<vfloat4,vfloat4>(parent->getTessellationCache(),baseEntry->at(interpolationSlot(primID,i/4,stride)),parent->commitCounterSubdiv,
                                       getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
                                       P ? &Pt : nullptr, 
                                       dPdu ? &dPdut : nullptr, 
@@ -686,7 +714,7 @@ namespace embree
         for (size_t j=0; j<numFloats; j+=4) 
         {
           const size_t M = min(size_t(4),numFloats-j);
-          isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),parent->commitCounterSubdiv,
+          isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(parent->getTessellationCache(),baseEntry->at(interpolationSlot(primID,j/4,stride)),parent->commitCounterSubdiv,
                                                            getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                            P ? P+j*numUVs+i : nullptr,
                                                            dPdu ? dPdu+j*numUVs+i : nullptr,
@@ -86,6 +86,10 @@ namespace embree
     void setMask (unsigned mask);
     void setBoundaryMode (RTCBoundaryMode mode);
     void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    size_t getBufferSize(RTCBufferType type) const;
+
+    /*! returns the number of bytes used by the half edge structures */
+    size_t getHalfEdgeBytes() const;
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
     void update ();
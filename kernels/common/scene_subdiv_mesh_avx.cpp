@@ -54,7 +54,7 @@ namespace embree
       if (i+4 >= numFloats)
       {
         vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;; 
-        isa::PatchEval<vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+        isa::PatchEval<vfloat4>(parent->getTessellationCache(),baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
                                 getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
                                 P ? &Pt : nullptr, 
                                 dPdu ? &dPdut : nullptr, 
@@ -87,7 +87,7 @@ namespace embree
       else
       {
         vfloat8 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt; 
-        isa::PatchEval<vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+        isa::PatchEval<vfloat8>(parent->getTessellationCache(),baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
                                 getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
                                 P ? &Pt : nullptr, 
                                 dPdu ? &dPdut : nullptr, 
@@ -149,7 +149,7 @@ namespace embree
         if (j+4 >= numFloats)
         {
           const size_t M = min(size_t(4),numFloats-j);
-          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat4>(parent->getTessellationCache(),baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
                                                         getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                         P ? P+j*numUVs : nullptr,
                                                         dPdu ? dPdu+j*numUVs : nullptr,
@@ -163,7 +163,7 @@ namespace embree
         else
         {
           const size_t M = min(size_t(8),numFloats-j);
-          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat8>(baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
+          isa::PatchEvalSimd<vbool,vint,vfloat,vfloat8>(parent->getTessellationCache(),baseEntry->at(interpolationSlot(primID,slot,stride)),parent->commitCounterSubdiv,
                                                         getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                         P ? P+j*numUVs : nullptr,
                                                         dPdu ? dPdu+j*numUVs : nullptr,
@@ -90,7 +90,18 @@ namespace embree
 
     max_spatial_split_replications = 2.0f;
 
+    sah_trav_cost = 1.0f;
+    sah_int_cost = 1.0f;
+    sah_max_leaf_size = size_t(inf);
+    sah_calibrate = false;
+    build_memory_limit = 0;
+    toplevel_refit_threshold = 1.3f;
+    numa_alloc = false;
+    numa_replicate_levels = 0;
+    alloc_retain_factor = 1.5f;
+
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_numa = false;
 
     /* large default cache size only for old mode single device mode */
 #if defined(__X86_64__)
@@ -115,6 +126,7 @@ namespace embree
 #endif
     /* per default enable affinity on KNL */
     if (hasISA(AVX512KNL)) set_affinity = true;
+    affinity_policy = AFFINITY_SMT;
 
     start_threads = false;
 
@@ -215,6 +227,14 @@ namespace embree
     else return SSE2;
   }
 
+  ThreadAffinityPolicy string_to_affinity_policy(const std::string& policy)
+  {
+    if      (policy == "smt"    ) return AFFINITY_SMT;
+    else if (policy == "compact") return AFFINITY_COMPACT;
+    else if (policy == "scatter") return AFFINITY_SCATTER;
+    else return AFFINITY_SMT;
+  }
+
   void State::parse(Ref<TokenStream> cin)
   {
     /* parse until end of stream */
@@ -233,6 +253,11 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("affinity_policy")&& cin->trySymbol("=")) {
+        affinity_policy = string_to_affinity_policy(toLowerCase(cin->get().Identifier()));
+        set_affinity = true;
+      }
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa = toLowerCase(cin->get().Identifier());
@@ -346,10 +371,32 @@ namespace embree
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
 
+      else if (tok == Token::Id("sah_trav_cost") && cin->trySymbol("="))
+        sah_trav_cost = cin->get().Float();
+      else if (tok == Token::Id("sah_int_cost") && cin->trySymbol("="))
+        sah_int_cost = cin->get().Float();
+      else if (tok == Token::Id("sah_max_leaf_size") && cin->trySymbol("="))
+        sah_max_leaf_size = cin->get().Int();
+      else if (tok == Token::Id("sah_calibrate") && cin->trySymbol("="))
+        sah_calibrate = cin->get().Int();
+
+      else if (tok == Token::Id("build_memory_limit") && cin->trySymbol("="))
+        build_memory_limit = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("toplevel_refit_threshold") && cin->trySymbol("="))
+        toplevel_refit_threshold = cin->get().Float();
+      else if (tok == Token::Id("numa_alloc") && cin->trySymbol("="))
+        numa_alloc = cin->get().Int();
+      else if (tok == Token::Id("numa_replicate_levels") && cin->trySymbol("="))
+        numa_replicate_levels = cin->get().Int();
+      else if (tok == Token::Id("alloc_retain_factor") && cin->trySymbol("="))
+        alloc_retain_factor = cin->get().Float();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_numa") && cin->trySymbol("="))
+        tessellation_cache_numa = cin->get().Int();
 
       cin->trySymbol(","); // optional , separator
     }
@@ -365,9 +412,23 @@ namespace embree
     std::cout << "  build threads = " << numThreads   << std::endl;
     std::cout << "  start_threads = " << start_threads << std::endl;
     std::cout << "  affinity      = " << set_affinity << std::endl;
+    std::cout << "  affinity_policy = " << affinity_policy << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  cache_numa    = " << tessellation_cache_numa << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  numa_nodes    = " << getNumberOfNumaNodes() << std::endl;
+    std::cout << "  numa_alloc    = " << numa_alloc << std::endl;
+    std::cout << "  numa_replicate_levels = " << numa_replicate_levels << std::endl;
+    std::cout << "  alloc_retain_factor = " << alloc_retain_factor << std::endl;
+
+    std::cout << "SAH builders:" << std::endl;
+    std::cout << "  trav_cost     = " << sah_trav_cost << std::endl;
+    std::cout << "  int_cost      = " << sah_int_cost << std::endl;
+    std::cout << "  max_leaf_size = " << sah_max_leaf_size << std::endl;
+    std::cout << "  calibrate     = " << sah_calibrate << std::endl;
+    std::cout << "  memory_limit  = " << float(build_memory_limit)*1E-6 << " MB" << std::endl;
+    std::cout << "  refit_threshold = " << toplevel_refit_threshold << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
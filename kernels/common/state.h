@@ -107,6 +107,20 @@ namespace embree
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    bool tessellation_cache_numa;          //!< one shared tessellation cache of the full size per NUMA node
+
+  public:
+    bool numa_alloc;                       //!< BVH memory blocks get placed on the NUMA node of the thread that fills them
+    size_t numa_replicate_levels;          //!< number of top levels of a BVH that get replicated per NUMA node, 0 disables replication
+    float alloc_retain_factor;             //!< BVH memory kept across rebuilds relative to the high-water mark of the last builds, 0 keeps all memory
+
+  public:
+    float sah_trav_cost;                   //!< SAH cost of a traversal step, used by the SAH builders
+    float sah_int_cost;                    //!< scales primitive intersection cost of the SAH builders
+    size_t sah_max_leaf_size;              //!< maximal number of primitives in leaves of the SAH builders
+    bool sah_calibrate;                    //!< measures SAH costs for the CPU at device creation time
+    size_t build_memory_limit;             //!< builds streamed in chunks when primitive references exceed this many bytes, 0 disables streaming
+    float toplevel_refit_threshold;        //!< two-level builders refit the toplevel until its SAH grows by this factor, 0 disables refitting
 
   public:
     bool float_exceptions;                 //!< enable floating point exceptions
@@ -117,6 +131,7 @@ namespace embree
   public:
     size_t numThreads;                     //!< number of threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
+    ThreadAffinityPolicy affinity_policy;  //!< how worker threads are mapped to the CPU topology when affinity is set
     bool start_threads;                    //!< true when threads should be started at device creation time
     int enabled_cpu_features;              //!< CPU ISA features to use
 
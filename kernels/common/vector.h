@@ -35,8 +35,6 @@ namespace embree
       typedef std::size_t size_type;
       typedef std::ptrdiff_t difference_type;
       
-      static const size_t PAGE_SIZE_2M = 2*1024*1024;
-
       __forceinline aligned_monitored_allocator(MemoryMonitorInterface* device) 
         : device(device) {}
 
@@ -45,7 +43,7 @@ namespace embree
         assert(device);
         device->memoryMonitor(n*sizeof(T),false);
 #if defined(__LINUX__) && defined(__AVX512F__)
-        if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
+        if (n*sizeof(value_type) >= 14 * getHugePageSize())
         {
           pointer p =  (pointer) os_malloc(n*sizeof(value_type));
           assert(p);
@@ -61,7 +59,7 @@ namespace embree
         if (p)
         {
 #if defined(__LINUX__) && defined(__AVX512F__)
-          if (n*sizeof(value_type) >= 14 * PAGE_SIZE_2M)
+          if (n*sizeof(value_type) >= 14 * getHugePageSize())
            os_free(p,n*sizeof(value_type)); 
           else
             alignedFree(p);
@@ -30,11 +30,14 @@ namespace embree
     { 
     public:
       __forceinline SubdivPatch1CachedPrecalculations (const Ray& ray, const void* ptr, unsigned numTimeSteps)
-        : T(ray,ptr,numTimeSteps) {}
+        : T(ray,ptr,numTimeSteps), cache(nullptr) {}
       
       __forceinline ~SubdivPatch1CachedPrecalculations() {
-        if (cached && this->grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+        if (cached && this->grid) cache->unlock();
       }
+
+    public:
+      SharedLazyTessellationCache* cache; //!< cache the current grid is locked in
     };
 
     template<int K, typename T, bool cached>
@@ -42,11 +45,14 @@ namespace embree
     { 
     public:
       __forceinline SubdivPatch1CachedPrecalculationsK (const vbool<K>& valid, RayK<K>& ray, unsigned numTimeSteps)
-        : T(valid,ray,numTimeSteps) {}
+        : T(valid,ray,numTimeSteps), cache(nullptr) {}
       
       __forceinline ~SubdivPatch1CachedPrecalculationsK() {
-        if (cached && this->grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+        if (cached && this->grid) cache->unlock();
       }
+
+    public:
+      SharedLazyTessellationCache* cache; //!< cache the current grid is locked in
     };
 
     template<bool cached>
@@ -63,9 +69,11 @@ namespace embree
         if (cached) 
         {          
           Scene* scene = context->scene;
-          if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
-          grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
-              auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+          if (pre.grid) pre.cache->unlock();
+          SharedLazyTessellationCache& cache = scene->getTessellationCache();
+          pre.cache = &cache;
+          grid = (GridSOA*) cache.lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
+              auto alloc = [&] (const size_t bytes) { return cache.malloc(bytes); };
               return GridSOA::create((SubdivPatch1Base*)prim,1,1,scene,alloc);
             });
         }
@@ -112,9 +120,11 @@ namespace embree
         if (cached) 
         {
           Scene* scene = context->scene;
-          if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
-          grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
-              auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+          if (pre.grid) pre.cache->unlock();
+          SharedLazyTessellationCache& cache = scene->getTessellationCache();
+          pre.cache = &cache;
+          grid = (GridSOA*) cache.lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
+              auto alloc = [&] (const size_t bytes) { return cache.malloc(bytes); };
               return GridSOA::create((SubdivPatch1Base*)prim,(unsigned)scene->getSubdivMesh(prim->geom)->numTimeSteps,pre.numTimeSteps(),scene,alloc);
             });
         }
@@ -160,9 +170,11 @@ namespace embree
         if (cached)
         {
           Scene* scene = context->scene;
-          if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
-          grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
-              auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+          if (pre.grid) pre.cache->unlock();
+          SharedLazyTessellationCache& cache = scene->getTessellationCache();
+          pre.cache = &cache;
+          grid = (GridSOA*) cache.lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
+              auto alloc = [&] (const size_t bytes) { return cache.malloc(bytes); };
               return GridSOA::create((SubdivPatch1Base*)prim,1,1,scene,alloc);
             });
         }
@@ -220,9 +232,11 @@ namespace embree
         if (cached)
         {
           Scene* scene = context->scene;
-          if (pre.grid) SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
-          grid = (GridSOA*) SharedLazyTessellationCache::lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
-              auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(bytes); };
+          if (pre.grid) pre.cache->unlock();
+          SharedLazyTessellationCache& cache = scene->getTessellationCache();
+          pre.cache = &cache;
+          grid = (GridSOA*) cache.lookup(prim->entry(),scene->commitCounterSubdiv,[&] () {
+              auto alloc = [&] (const size_t bytes) { return cache.malloc(bytes); };
               return GridSOA::create((SubdivPatch1Base*)prim,(unsigned)scene->getSubdivMesh(prim->geom)->numTimeSteps,pre.numTimeSteps(),scene,alloc);
             });
         }
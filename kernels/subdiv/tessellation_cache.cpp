@@ -18,31 +18,79 @@
 
 namespace embree
 {
+  /* cache IDs in use and epoch of the next cache, have to get initialized before the shared cache */
+  static std::atomic<size_t> g_cache_ids(0);
+  static std::atomic<size_t> g_cache_epoch(1);
+
+  /* last local time of destroyed caches per ID, caches reusing an ID start later to invalidate all old tags with that ID */
+  static std::atomic<size_t> g_cache_id_time[SharedLazyTessellationCache::MAX_TESSELLATION_CACHES];
+
   SharedLazyTessellationCache SharedLazyTessellationCache::sharedLazyTessellationCache;
+  SharedLazyTessellationCache* SharedLazyTessellationCache::numaCaches[MAX_TESSELLATION_CACHES] = { &SharedLazyTessellationCache::sharedLazyTessellationCache };
+  size_t SharedLazyTessellationCache::numNumaCaches = 1;
+
+  __thread SharedLazyTessellationCache::ThreadWorkStateRef SharedLazyTessellationCache::t_state[MAX_TESSELLATION_CACHES];
 
-  __thread ThreadWorkState* SharedLazyTessellationCache::init_t_state = nullptr;
-  ThreadWorkState* SharedLazyTessellationCache::current_t_state = nullptr;
+  /* NUMA node caches are maximally using half of the cache IDs, the others are left for per scene caches */
+  static const size_t MAX_NUMA_TESSELLATION_CACHES = SharedLazyTessellationCache::MAX_TESSELLATION_CACHES/2;
 
-  void resizeTessellationCache(size_t new_size)
+  static struct NumaTessellationCacheCleanup 
+  {
+    ~NumaTessellationCacheCleanup() {
+      for (size_t i=1; i<MAX_NUMA_TESSELLATION_CACHES; i++) {
+        delete SharedLazyTessellationCache::numaCaches[i];
+        SharedLazyTessellationCache::numaCaches[i] = nullptr;
+      }
+    }
+  } numaTessellationCacheCleanup;
+
+  void resizeTessellationCache(size_t new_size, bool per_numa_node)
   {    
     if (new_size >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
       new_size = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
-    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size) 
-      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
+
+    const size_t numCaches = per_numa_node ? max(size_t(1),min(getNumberOfNumaNodes(),MAX_NUMA_TESSELLATION_CACHES)) : 1;
+    SharedLazyTessellationCache::sharedLazyTessellationCache.numaNode = numCaches > 1 ? 0 : -1;
+    for (size_t i=1; i<numCaches; i++)
+      if (SharedLazyTessellationCache::numaCaches[i] == nullptr)
+        SharedLazyTessellationCache::numaCaches[i] = new SharedLazyTessellationCache(i);
+
+    /* disable the caches of all NUMA nodes before resizing, the remaining ones get their memory released */
+    SharedLazyTessellationCache::numNumaCaches = 1;
+    for (size_t i=0; i<MAX_NUMA_TESSELLATION_CACHES; i++) 
+    {
+      SharedLazyTessellationCache* cache = SharedLazyTessellationCache::numaCaches[i];
+      const size_t size = i < numCaches ? new_size : 0;
+      if (cache && cache->getSize() != size) 
+        cache->realloc(size);
+    }
+    SharedLazyTessellationCache::numNumaCaches = numCaches;
   }
 
   void resetTessellationCache()
   {
-    //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
-    SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
+    for (size_t i=0; i<SharedLazyTessellationCache::numNumaCaches; i++)
+      SharedLazyTessellationCache::numaCaches[i]->reset();
   }
   
-  SharedLazyTessellationCache::SharedLazyTessellationCache()
+  SharedLazyTessellationCache::SharedLazyTessellationCache(ssize_t numaNode)
   {
+    /* allocate a free cache ID */
+    size_t ids = g_cache_ids.load();
+    do {
+      if (ids == (size_t(1) << MAX_TESSELLATION_CACHES)-1)
+        throw_RTCError(RTC_OUT_OF_MEMORY,"too many tessellation caches");
+      id = __bsf(~ids);
+    } while (!g_cache_ids.compare_exchange_weak(ids,ids | (size_t(1) << id)));
+    epoch = g_cache_epoch++;
+
+    this->numaNode = numaNode;
     size = 0;
     data = nullptr;
+    current_t_state = nullptr;
+    flushes = 0;
     maxBlocks              = size/BLOCK_SIZE;
-    localTime              = NUM_CACHE_SEGMENTS;
+    localTime              = g_cache_id_time[id] + NUM_CACHE_SEGMENTS;
     next_block             = 0;
     numRenderThreads       = 0;
 #if FORCE_SIMPLE_FLUSH == 1
@@ -66,19 +114,48 @@ namespace embree
     }
 
     delete[] threadWorkState;
+    if (data) os_free(data,size);
+
+    /* release cache ID */
+    size_t time = g_cache_id_time[id].load();
+    while (time < localTime && !g_cache_id_time[id].compare_exchange_weak(time,localTime));
+    g_cache_ids.fetch_and(~(size_t(1) << id));
   }
 
-  void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
+  void SharedLazyTessellationCache::getNextRenderThreadWorkState(ThreadWorkStateRef& ref) 
   {
-    const size_t id = numRenderThreads.fetch_add(1); 
-    if (id >= NUM_PREALLOC_THREAD_WORK_STATES) init_t_state = new ThreadWorkState(true);
-    else                                       init_t_state = &threadWorkState[id];
+    const size_t threadID = numRenderThreads.fetch_add(1); 
+    ThreadWorkState* state = nullptr;
+    if (threadID >= NUM_PREALLOC_THREAD_WORK_STATES) state = new ThreadWorkState(true);
+    else                                             state = &threadWorkState[threadID];
     
     /* critical section for updating link list with new thread state */
     linkedlist_mtx.lock();
-    init_t_state->next = current_t_state;
-    current_t_state = init_t_state;
+    state->next = current_t_state;
+    current_t_state = state;
     linkedlist_mtx.unlock();
+
+    ref.state = state;
+    ref.epoch = epoch;
+  }
+
+  void SharedLazyTessellationCache::getStatistics(Statistics& stats)
+  {
+    Lock<SpinLock> lock(linkedlist_mtx);
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      stats.hits           += t->hits.load();
+      stats.misses         += t->misses.load();
+      stats.allocatedBytes += t->allocatedBytes.load();
+    }
+    stats.flushes += flushes.load();
+    stats.bytes   += size;
+  }
+
+  void SharedLazyTessellationCache::getSharedStatistics(Statistics& stats)
+  {
+    memset(&stats,0,sizeof(stats));
+    for (size_t i=0; i<numNumaCaches; i++)
+      numaCaches[i]->getStatistics(stats);
   }
 
   void SharedLazyTessellationCache::waitForUsersLessEqual(ThreadWorkState *const t_state,
@@ -110,7 +187,6 @@ namespace embree
 
             /* switch to the next segment */
 	    addCurrentIndex();
-	    CACHE_STATS(PRINT("RESET TESS CACHE"));
 
 #if FORCE_SIMPLE_FLUSH == 1
 	    next_block = 0;
@@ -122,7 +198,7 @@ namespace embree
 	    assert( switch_block_threshold <= maxBlocks );
 #endif
 
-	    CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
+	    flushes++;
 
             /* release all blocked threads */
 
@@ -195,6 +271,7 @@ namespace embree
     size      = new_size;
     data      = nullptr;
     if (size) data = (float*)os_malloc(size); // FIXME: do os_reserve under linux
+    if (size && numaNode >= 0) os_bind_numa(data,size,numaNode);
     maxBlocks = size/BLOCK_SIZE;    
 
     /* invalidate entire cache */
@@ -227,64 +304,6 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  std::atomic<size_t> *SharedTessellationCacheStats::cache_patch_builds(nullptr);
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
-
-  void SharedTessellationCacheStats::printStats()
-  {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
-    size_t patches = 0;
-    size_t builds  = 0;
-    for (size_t i=0;i<cache_num_patches;i++)
-      if (cache_patch_builds[i])
-	{
-	  patches++;
-	  builds += cache_patch_builds[i];
-	}
-    PRINT(patches);
-    PRINT(builds);
-    PRINT((double)builds/patches);
-  }
-
-  void SharedTessellationCacheStats::clearStats()
-  {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
-    for (size_t i=0;i<cache_num_patches;i++)
-      cache_patch_builds[i] = 0;
-  }
-
-  void SharedTessellationCacheStats::incPatchBuild(const size_t ID, const size_t numPatches)
-  {
-    if (!cache_patch_builds)
-      {
-	mtx.lock();
-	if (!cache_patch_builds)
-	  {
-	    PRINT(numPatches);
-	    cache_num_patches = numPatches;
-	    cache_patch_builds = (std::atomic<size_t>*)os_malloc(numPatches*sizeof(std::atomic<size_t>));
-	    memset(cache_patch_builds,0,numPatches*sizeof(std::atomic<size_t>));
-	  }
-	mtx.unlock();
-      }
-    assert(ID < cache_num_patches);
-    cache_patch_builds[ID]++;
-  }
-
   struct cache_regression_test : public RegressionTest
   {
     BarrierSys barrier;
@@ -302,7 +321,8 @@ namespace embree
     static void thread_alloc(cache_regression_test* This)
     {
       int threadID = This->threadIDCounter++;
-      size_t maxN = SharedLazyTessellationCache::sharedLazyTessellationCache.maxAllocSize()/4;
+      SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+      size_t maxN = cache.maxAllocSize()/4;
       This->barrier.wait();
 
       for (size_t j=0; j<100000; j++)
@@ -310,14 +330,14 @@ namespace embree
         size_t elt = (threadID+j)%numEntries;
         size_t N = min(1+10*(elt%1000),maxN);
           
-        volatile int* data = (volatile int*) SharedLazyTessellationCache::lookup(This->entry[elt],0,[&] () {
-            int* data = (int*) SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(4*N);
+        volatile int* data = (volatile int*) cache.lookup(This->entry[elt],0,[&] () {
+            int* data = (int*) cache.malloc(4*N);
             for (size_t k=0; k<N; k++) data[k] = (int)elt;
             return data;
           });
         
         if (data == nullptr) {
-          SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+          cache.unlock();
           This->numFailed++;
           continue;
         }
@@ -330,7 +350,7 @@ namespace embree
           }
         }
         
-        SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+        cache.unlock();
       }
       This->barrier.wait();
     }
@@ -364,7 +384,12 @@ namespace embree
 
 extern "C" void printTessCacheStats()
 {
+  embree::SharedLazyTessellationCache::Statistics stats;
+  embree::SharedLazyTessellationCache::getSharedStatistics(stats);
   PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
+  PRINT(stats.hits);
+  PRINT(stats.misses);
+  PRINT(stats.flushes);
+  PRINT(stats.bytes);
+  PRINT(stats.allocatedBytes);
 }
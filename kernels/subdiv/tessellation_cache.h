@@ -23,33 +23,10 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
-  {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static std::atomic<size_t> *cache_patch_builds;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
-    static void incPatchBuild(const size_t ID, const size_t numPatches);
-  };
-  
-  void resizeTessellationCache(size_t new_size);
+  /*! resizes the device wide tessellation cache, optionally with one instance per NUMA node */
+  void resizeTessellationCache(size_t new_size, bool per_numa_node = false);
   void resetTessellationCache();
   
  ////////////////////////////////////////////////////////////////////////////////
@@ -64,8 +41,13 @@ namespace embree
    ThreadWorkState* next;
    bool allocated;
 
+   /* statistics, only written by the owning thread */
+   std::atomic<size_t> hits;
+   std::atomic<size_t> misses;
+   std::atomic<size_t> allocatedBytes;
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), hits(0), misses(0), allocatedBytes(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
@@ -73,54 +55,75 @@ namespace embree
 
  class __aligned(64) SharedLazyTessellationCache 
  {
+   ALIGNED_CLASS;
+   friend void resizeTessellationCache(size_t new_size, bool per_numa_node);
+
  public:
    
    //static const size_t DEFAULT_TESSELLATION_CACHE_SIZE = MAX_TESSELLATION_CACHE_SIZE; 
    static const size_t NUM_CACHE_SEGMENTS              = 8;
    static const size_t NUM_PREALLOC_THREAD_WORK_STATES = MAX_THREADS;
    static const size_t COMMIT_INDEX_SHIFT              = 32+8;
+   static const size_t CACHE_ID_SHIFT                  = 32+4;
+   static const size_t CACHE_ID_MASK                   = 0xf;
 #if defined(__X86_64__)
-   static const size_t REF_TAG_MASK                    = 0xffffffffff;
+   static const size_t REF_TAG_MASK                    = 0xfffffffff;
 #else
    static const size_t REF_TAG_MASK                    = 0x7FFFFFFF;
 #endif
    static const size_t MAX_TESSELLATION_CACHE_SIZE     = REF_TAG_MASK+1;
+   static const size_t MAX_TESSELLATION_CACHES         = CACHE_ID_MASK+1;
    static const size_t BLOCK_SIZE                      = 64;
-   
 
-    /*! Per thread tessellation ref cache */
-   static __thread ThreadWorkState* init_t_state;
-   static ThreadWorkState* current_t_state;
-   
-   static __forceinline ThreadWorkState *threadState() 
+   /*! statistics of a cache instance */
+   struct Statistics
+   {
+     size_t hits;            //!< lookups that found valid tessellation data
+     size_t misses;          //!< lookups that had to tessellate
+     size_t flushes;         //!< switches to the next cache segment
+     size_t bytes;           //!< size of the cache
+     size_t allocatedBytes;  //!< tessellation data written into the cache
+   };
+
+   /*! Per thread tessellation ref cache, one slot per cache ID, the
+    *  epoch detects slots of destroyed caches whose ID got reused */
+   struct ThreadWorkStateRef 
+   {
+     size_t epoch;
+     ThreadWorkState* state;
+   };
+   static __thread ThreadWorkStateRef t_state[MAX_TESSELLATION_CACHES];
+
+   __forceinline ThreadWorkState *threadState() 
    {
-     if (unlikely(!init_t_state))
-       /* sets init_t_state, can't return pointer due to macosx icc bug*/
-       SharedLazyTessellationCache::sharedLazyTessellationCache.getNextRenderThreadWorkState();
-     return init_t_state;
+     ThreadWorkStateRef& ref = t_state[id];
+     if (unlikely(ref.epoch != epoch))
+       getNextRenderThreadWorkState(ref);
+     return ref.state;
    }
 
    struct Tag
    {
      __forceinline Tag() : data(0) {}
 
-     __forceinline Tag(void* ptr, size_t combinedTime) { 
-       init(ptr,combinedTime);
+     __forceinline Tag(SharedLazyTessellationCache& cache, void* ptr, size_t combinedTime) { 
+       init(cache,ptr,combinedTime);
      }
 
-     __forceinline Tag(size_t ptr, size_t combinedTime) {
-       init((void*)ptr,combinedTime); 
+     __forceinline Tag(SharedLazyTessellationCache& cache, size_t ptr, size_t combinedTime) {
+       init(cache,(void*)ptr,combinedTime); 
      }
 
-     __forceinline void init(void* ptr, size_t combinedTime)
+     __forceinline void init(SharedLazyTessellationCache& cache, void* ptr, size_t combinedTime)
      {
        if (ptr == nullptr) {
          data = 0;
          return;
        }
        int64_t new_root_ref = (int64_t) ptr;
-       new_root_ref -= (int64_t)SharedLazyTessellationCache::sharedLazyTessellationCache.getDataPtr();                                
+       new_root_ref -= (int64_t)cache.getDataPtr();                                
        assert( new_root_ref <= (int64_t)REF_TAG_MASK );
+       new_root_ref |= (int64_t)cache.id << CACHE_ID_SHIFT; 
        new_root_ref |= (int64_t)combinedTime << COMMIT_INDEX_SHIFT; 
        data = new_root_ref;
      }
@@ -134,6 +137,7 @@ namespace embree
    };
 
    static __forceinline size_t extractCommitIndex(const int64_t v) { return v >> SharedLazyTessellationCache::COMMIT_INDEX_SHIFT; }
+   static __forceinline size_t extractCacheID(const int64_t v) { return (v >> SharedLazyTessellationCache::CACHE_ID_SHIFT) & CACHE_ID_MASK; }
 
    struct CacheEntry
    {
@@ -146,7 +150,12 @@ namespace embree
    float *data;
    size_t size;
    size_t maxBlocks;
+   size_t id;                            //!< cache ID stored in the tags, distinguishes tessellation data of different caches
+   size_t epoch;                         //!< unique over all caches ever created
+   ssize_t numaNode;                     //!< NUMA node the data gets placed on, -1 for no placement
    ThreadWorkState *threadWorkState;
+   ThreadWorkState *current_t_state;
+   std::atomic<size_t> flushes;
       
    __aligned(64) std::atomic<size_t> localTime;
    __aligned(64) std::atomic<size_t> next_block;
@@ -159,10 +168,23 @@ namespace embree
  public:
 
       
-   SharedLazyTessellationCache();
+   SharedLazyTessellationCache(ssize_t numaNode = -1);
    ~SharedLazyTessellationCache();
 
-   void getNextRenderThreadWorkState();
+   void getNextRenderThreadWorkState(ThreadWorkStateRef& ref);
+
+   /*! returns the device wide cache to use by the calling thread */
+   static __forceinline SharedLazyTessellationCache& sharedCache() 
+   {
+     if (likely(numNumaCaches <= 1)) return sharedLazyTessellationCache;
+     return *numaCaches[getNumaNode() % numNumaCaches];
+   }
+
+   /*! sums up the statistics of all device wide caches */
+   static void getSharedStatistics(Statistics& stats);
+
+   /*! returns the statistics of this cache */
+   void getStatistics(Statistics& stats);
 
    __forceinline size_t maxAllocSize() const {
      return switch_block_threshold;
@@ -181,83 +203,78 @@ namespace embree
 
    __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
 
-   static __forceinline void lock  () { sharedLazyTessellationCache.lockThread(threadState()); }
-   static __forceinline void unlock() { sharedLazyTessellationCache.unlockThread(threadState()); }
-   static __forceinline bool isLocked() { return sharedLazyTessellationCache.isLocked(threadState()); }
-   static __forceinline size_t getState() { return threadState()->counter.load(); }
-   static __forceinline void lockThreadLoop() { sharedLazyTessellationCache.lockThreadLoop(threadState()); }
-
-   static __forceinline size_t getTCacheTime(const size_t globalTime) {
-     return sharedLazyTessellationCache.getTime(globalTime);
-   }
+   __forceinline void lock  () { lockThread(threadState()); }
+   __forceinline void unlock() { unlockThread(threadState()); }
+   __forceinline bool isLocked() { return isLocked(threadState()); }
+   __forceinline size_t getState() { return threadState()->counter.load(); }
+   __forceinline void lockThreadLoop() { lockThreadLoop(threadState()); }
 
    /* per thread lock */
    __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
    { 
      while(1)
      {
-       size_t lock = SharedLazyTessellationCache::sharedLazyTessellationCache.lockThread(t_state,1);
+       size_t lock = lockThread(t_state,1);
        if (unlikely(lock >= THREAD_BLOCK_ATOMIC_ADD))
        {
          /* lock failed wait until sync phase is over */
-         sharedLazyTessellationCache.unlockThread(t_state,-1);	       
-         sharedLazyTessellationCache.waitForUsersLessEqual(t_state,0);
+         unlockThread(t_state,-1);	       
+         waitForUsersLessEqual(t_state,0);
        }
        else
          break;
      }
    }
 
-   static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
+   __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
-     if (likely(subdiv_patch_root_ref != 0)) 
+     if (likely(subdiv_patch_root_ref != 0 && extractCacheID(subdiv_patch_root_ref) == id)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
+       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+       if (likely( validCacheIndex(subdiv_patch_cache_index,globalTime) ))
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
+     __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
    {
-     ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
+     ThreadWorkState *t_state = threadState();
 
      while (true)
      {
-       sharedLazyTessellationCache.lockThreadLoop(t_state);
-       void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       lockThreadLoop(t_state);
+       void* patch = lookup(entry,globalTime);
+       if (patch) {
+         t_state->hits.store(t_state->hits.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           t_state->misses.store(t_state->misses.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+           auto timeBefore = getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
+           auto timeAfter = getTime(globalTime);
            auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
-           entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+           entry.tag = SharedLazyTessellationCache::Tag(*this,ret,time);
            __memory_barrier();
            entry.mutex.unlock();
            return ret;
          }
          entry.mutex.unlock();
        }
-       SharedLazyTessellationCache::sharedLazyTessellationCache.unlockThread(t_state);
+       unlockThread(t_state);
      }
    }
    
@@ -276,12 +293,13 @@ namespace embree
    }
 
 
-    static __forceinline bool validTag(const Tag& tag, size_t globalTime)
+    __forceinline bool validTag(const Tag& tag, size_t globalTime)
     {
       const int64_t subdiv_patch_root_ref = tag.get(); 
       if (subdiv_patch_root_ref == 0) return false;
+      if (extractCacheID(subdiv_patch_root_ref) != id) return false;
       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      return validCacheIndex(subdiv_patch_cache_index,globalTime);
     }
 
    void waitForUsersLessEqual(ThreadWorkState *const t_state,
@@ -298,23 +316,24 @@ namespace embree
      return index;
    }
 
-   static __forceinline void* malloc(const size_t bytes)
+   __forceinline void* malloc(const size_t bytes)
    {
      size_t block_index = -1;
      ThreadWorkState *const t_state = threadState();
      while (true)
      {
-       block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
+       block_index = alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
        if (block_index == (size_t)-1)
        {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
-         sharedLazyTessellationCache.lockThread(t_state);
+         unlockThread(t_state);		  
+         allocNextSegment();
+         lockThread(t_state);
          continue; 
        }
        break;
      }
-     return sharedLazyTessellationCache.getBlockPtr(block_index);
+     t_state->allocatedBytes.store(t_state->allocatedBytes.load(std::memory_order_relaxed)+bytes,std::memory_order_relaxed);
+     return getBlockPtr(block_index);
    }
 
    __forceinline void *getBlockPtr(const size_t block_index)
@@ -335,6 +354,11 @@ namespace embree
 
    void reset();
 
+   /*! device wide cache, also the instance of NUMA node 0 */
    static SharedLazyTessellationCache sharedLazyTessellationCache;
+
+   /*! device wide caches per NUMA node */
+   static SharedLazyTessellationCache* numaCaches[MAX_TESSELLATION_CACHES];
+   static size_t numNumaCaches;
  };
 }
@@ -19,6 +19,7 @@
 namespace embree
 {
   extern "C" { int g_instancing_mode = 0; }
+  extern "C" { int g_thread_sweep = 0; }
 
   struct Tutorial : public SceneLoadingTutorialApplication
   {
@@ -26,6 +27,10 @@ namespace embree
       : SceneLoadingTutorialApplication("build_bench",FEATURE_RTCORE) 
     {
       interactive = false;
+
+      registerOption("thread-sweep", [this] (Ref<ParseStream> cin, const FileName& path) {
+        g_thread_sweep = 1;
+      }, "--thread-sweep: measures static scene build performance for 1 to 128 build threads");
     }
     
     void postParseCommandLine() 
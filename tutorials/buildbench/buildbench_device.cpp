@@ -25,6 +25,7 @@ namespace embree {
   static const size_t iterations_static_static   = 30;
 
   extern "C" ISPCScene* g_ispc_scene;
+  extern "C" int g_thread_sweep;
 
 /* scene data */
   RTCDevice g_device = nullptr;
@@ -358,6 +359,60 @@ namespace embree {
     g_scene = nullptr;    
   }
 
+  void Benchmark_StaticStatic_Load(ISPCScene* scene_in, size_t benchmark_iterations)
+  {
+    assert(g_scene == nullptr);
+    const char* filename = "buildbench.bvh";
+    size_t primitives = getNumPrimitives(scene_in);
+
+    /* build scene once and store its BVH */
+    g_scene = createScene(RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC);
+    convertScene(g_scene,scene_in,RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC);
+    rtcSaveBVH(g_scene,filename);
+    rtcDeleteScene (g_scene);
+    g_scene = nullptr;
+
+    size_t iterations = 0;
+    double time = 0.0;
+    for(size_t i=0;i<benchmark_iterations+skip_iterations;i++)
+    {
+      g_scene = createScene(RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC);
+      convertScene(g_scene,scene_in,RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC);
+
+      double t0 = getSeconds();
+      rtcLoadBVH (g_scene,filename);
+      double t1 = getSeconds();
+      if (i >= skip_iterations)
+      {
+        time += t1 - t0;      
+        iterations++;
+      }
+      rtcDeleteScene (g_scene);       
+    }
+    std::cout << "Load static scene, static geometry " 
+              << " (" << primitives << " primitives)  :  "
+              << " avg. time  = " <<  time/iterations 
+              << " , avg. load perf " << 1.0 / (time/iterations) * primitives / 1000000.0 << " Mprims/s" << std::endl;
+
+    remove(filename);
+    g_scene = nullptr;    
+  }
+
+
+  void Benchmark_StaticStatic_ThreadSweep(ISPCScene* scene_in, const std::string& cfg)
+  {
+    /* each device has to be the only one alive, as the tasking system uses the maximal thread count of all devices */
+    assert(g_device == nullptr);
+    for (size_t threads=1; threads<=128; threads*=2)
+    {
+      std::cout << "threads = " << threads << " : ";
+      g_device = rtcNewDevice((cfg+",threads="+std::to_string((long long)threads)).c_str());
+      error_handler(rtcDeviceGetError(g_device));
+      rtcDeviceSetErrorFunction(g_device,error_handler);
+      Benchmark_StaticStatic_Create(scene_in,iterations_static_static);
+      rtcDeleteDevice(g_device); g_device = nullptr;
+    }
+  }
 
 /* called by the C++ code for initialization */
   extern "C" void device_init (char* cfg)
@@ -379,8 +434,12 @@ namespace embree {
     Benchmark_DynamicStatic_Update(g_ispc_scene,iterations_dynamic_static);
     Benchmark_DynamicStatic_Create(g_ispc_scene,iterations_dynamic_static);
     Benchmark_StaticStatic_Create(g_ispc_scene,iterations_static_static);
+    Benchmark_StaticStatic_Load(g_ispc_scene,iterations_static_static);
 
     rtcDeleteDevice(g_device); g_device = nullptr;
+
+    if (g_thread_sweep)
+      Benchmark_StaticStatic_ThreadSweep(g_ispc_scene,init);
   }
 
 /* called by the C++ code to render */
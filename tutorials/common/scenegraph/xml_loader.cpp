@@ -264,6 +264,7 @@ namespace embree
     template<typename T> T load(const Ref<XML>& xml) { assert(false); return T(zero); }
     template<typename T> T load(const Ref<XML>& xml, const T& opt) { assert(false); return T(zero); }
     template<typename Vector> Vector loadBinary(const Ref<XML>& xml);
+    void readBinary(size_t ofs, void* dst, size_t bytes);
 
     std::vector<float> loadFloatArray(const Ref<XML>& xml);
     std::vector<Vec2f> loadVec2fArray(const Ref<XML>& xml);
@@ -277,8 +278,8 @@ namespace embree
 
   private:
     FileName path;         //!< path to XML file
-    FILE* binFile;         //!< .bin file for reading binary data
-    FileName binFileName;  //!< name of the .bin file
+    FileName binFileName;  //!< name of the .bin file for reading binary data, empty if not existing
+    size_t binOfs;         //!< end of the last range read from the .bin file
 
   private:
     std::map<std::string,Ref<SceneGraph::MaterialNode> > materialMap;     //!< named materials
@@ -402,24 +403,34 @@ namespace embree
     }
   }
 
+  /* the .bin file gets mapped instead of read through stdio, such
+   * that large scenes get copied only once from the page cache and do
+   * not require file offsets to fit into a long */
+  void XMLLoader::readBinary(size_t ofs, void* dst, size_t bytes)
+  {
+    if (binFileName.str() == "") 
+      THROW_RUNTIME_ERROR("cannot open .bin file for reading");
+
+    binOfs = ofs+bytes;
+    if (bytes == 0) return;
+
+    void* ptr = os_map_file(binFileName.c_str(),ofs,bytes);
+    if (!ptr) THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+    os_advise(ptr,bytes,true);
+    memcpy(dst,ptr,bytes);
+    os_unmap_file(ptr,bytes);
+  }
+
   template<typename Vector>
   Vector XMLLoader::loadBinary(const Ref<XML>& xml)
   {
-    if (!binFile) 
-      THROW_RUNTIME_ERROR("cannot open file "+binFileName.str()+" for reading");
-
     size_t ofs = atol(xml->parm("ofs").c_str());
-    fseek(binFile,long(ofs),SEEK_SET);
-
     size_t size = atol(xml->parm("size").c_str());
     if (size == 0) size = atol(xml->parm("num").c_str()); // version for BGF format
 
     Vector data;
     data.resize(size);
-
-    if (size != fread(data.data(), sizeof(typename Vector::value_type), size, binFile)) 
-      THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
-
+    readBinary(ofs,data.data(),size*sizeof(typename Vector::value_type));
     return data;
   }
 
@@ -674,8 +685,7 @@ namespace embree
       const Texture::Format format = Texture::string_to_format(xml->parm("format"));
       const unsigned bytesPerTexel = Texture::getFormatBytesPerTexel(format);
       texture = new Texture(width,height,format);
-      if (width*height != fread(texture->data, bytesPerTexel, width*height, binFile)) 
-        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      readBinary(binOfs,texture->data,size_t(width)*size_t(height)*bytesPerTexel); // texels follow the previously read data
     }
     
     if (id != "") textureMap[id] = texture;
@@ -1229,15 +1239,17 @@ namespace embree
     XMLLoader loader(fileName,space); return loader.root;
   }
 
-  XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space) : binFile(nullptr), currentNodeID(0)
+  XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space) : binOfs(0), currentNodeID(0)
   {
     path = fileName.path();
     binFileName = fileName.setExt(".bin");
-    binFile = fopen(binFileName.c_str(),"rb");
+    FILE* binFile = fopen(binFileName.c_str(),"rb");
     if (!binFile) {
       binFileName = fileName.addExt(".bin");
       binFile = fopen(binFileName.c_str(),"rb");
     }
+    if (binFile) fclose(binFile);
+    else binFileName = FileName();
 
     Ref<XML> xml = parseXML(fileName);
     if (xml->name == "scene") 
@@ -1265,7 +1277,6 @@ namespace embree
   }
 
   XMLLoader::~XMLLoader() {
-    if (binFile) fclose(binFile);
   }
 
   /*! read from disk */
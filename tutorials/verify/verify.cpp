@@ -993,6 +993,477 @@ namespace embree
     }
   };
 
+  struct SaveLoadBVHTest : public VerifyApplication::Test
+  {
+    SaveLoadBVHTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    bool compareHits(RTCScene scene0, RTCScene scene1)
+    {
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org(7.0f*random_float()-2.0f,4.0f*random_float()-2.0f,-5.0f);
+        RTCRay ray0 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene1,ray1);
+        if (ray0.geomID != ray1.geomID) return false;
+        if (ray0.primID != ray1.primID) return false;
+        if (ray0.tfar != ray1.tfar) return false;
+        if (ray0.u != ray1.u || ray0.v != ray1.v) return false;
+      }
+      return true;
+    }
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      const std::string fileName = "verify_save_load."+stringOfISA(isa)+".bvh";
+
+      Ref<SceneGraph::Node> triangles = SceneGraph::createTriangleSphere(zero,1.0f,50);
+      Ref<SceneGraph::Node> quads = SceneGraph::createQuadSphere(Vec3fa(3,0,0),1.0f,50);
+
+      /* scene that stores its BVH */
+      VerifyScene scene0(device,RTC_SCENE_STATIC,aflags);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,triangles);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      rtcSaveBVH(scene0,fileName.c_str());
+      AssertNoError(device);
+
+      /* identical scene that loads the BVH */
+      VerifyScene scene1(device,RTC_SCENE_STATIC,aflags);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,triangles);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      rtcLoadBVH(scene1,fileName.c_str());
+      AssertNoError(device);
+      bool passed = compareHits(scene0,scene1);
+
+      /* different scene has to reject the stored BVH and get built */
+      Ref<SceneGraph::Node> triangles2 = SceneGraph::createTriangleSphere(zero,1.0f,40);
+      VerifyScene scene2(device,RTC_SCENE_STATIC,aflags);
+      scene2.addGeometry(RTC_GEOMETRY_STATIC,triangles2);
+      scene2.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      rtcLoadBVH(scene2,fileName.c_str());
+      AssertNoError(device);
+      VerifyScene scene3(device,RTC_SCENE_STATIC,aflags);
+      scene3.addGeometry(RTC_GEOMETRY_STATIC,triangles2);
+      scene3.addGeometry(RTC_GEOMETRY_STATIC,quads);
+      rtcCommit(scene3);
+      AssertNoError(device);
+      passed &= compareHits(scene2,scene3);
+
+      remove(fileName.c_str());
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct FileBufferTest : public VerifyApplication::Test
+  {
+    FileBufferTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      const std::string fileName = "verify_file_buffer."+stringOfISA(isa)+".bin";
+
+      /* store vertices with 12 bytes stride after some header, such that the 4 bytes after the last vertex are inside the file */
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(zero,1.0f,50).dynamicCast<SceneGraph::TriangleMeshNode>();
+      const size_t numVertices = mesh->numVertices();
+      const size_t numTriangles = mesh->numPrimitives();
+      const size_t vertexOfs = 100;
+      const size_t indexOfs = vertexOfs + numVertices*sizeof(Vec3f);
+      FILE* file = fopen(fileName.c_str(),"wb");
+      if (!file) return VerifyApplication::FAILED;
+      char header[vertexOfs] = { 0 };
+      fwrite(header,sizeof(header),1,file);
+      for (size_t i=0; i<numVertices; i++) {
+        const Vec3f v(mesh->positions[0][i]);
+        fwrite(&v,sizeof(Vec3f),1,file);
+      }
+      fwrite(mesh->triangles.data(),sizeof(Triangle),numTriangles,file);
+      fclose(file);
+
+      VerifyScene scene0(device,RTC_SCENE_STATIC,aflags);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,mesh.dynamicCast<SceneGraph::Node>());
+      rtcCommit(scene0);
+      AssertNoError(device);
+
+      VerifyScene scene1(device,RTC_SCENE_STATIC,aflags);
+      unsigned geomID = rtcNewTriangleMesh(scene1,RTC_GEOMETRY_STATIC,numTriangles,numVertices);
+      rtcSetFileBuffer(scene1,geomID,RTC_VERTEX_BUFFER,fileName.c_str(),vertexOfs,sizeof(Vec3f),numVertices);
+      rtcSetFileBuffer(scene1,geomID,RTC_INDEX_BUFFER,fileName.c_str(),indexOfs,sizeof(Triangle),numTriangles);
+      AssertNoError(device);
+
+      /* buffers have to contain enough elements and have to be inside the file */
+      rtcSetFileBuffer(scene1,geomID,RTC_INDEX_BUFFER,fileName.c_str(),indexOfs,sizeof(Triangle),numTriangles-1);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      rtcSetFileBuffer(scene1,geomID,RTC_INDEX_BUFFER,fileName.c_str(),indexOfs+size_t(1<<20),sizeof(Triangle),numTriangles);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      rtcSetFileBuffer(scene1,geomID,RTC_INDEX_BUFFER,(fileName+".missing").c_str(),indexOfs,sizeof(Triangle),numTriangles);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      rtcCommit(scene1);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-5.0f);
+        RTCRay ray0 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene1,ray1);
+        passed &= ray0.primID == ray1.primID && ray0.tfar == ray1.tfar;
+      }
+      AssertNoError(device);
+
+      remove(fileName.c_str());
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct MemoryStatisticsTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    MemoryStatisticsTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,sflags,aflags);
+      scene.addSphere      (sampler,RTC_GEOMETRY_STATIC,Vec3fa(-1,0,-1),1.0f,50);
+      scene.addSubdivSphere(sampler,RTC_GEOMETRY_STATIC,Vec3fa(+1,0,-1),1.0f,5,4);
+      AssertNoError(device);
+
+      RTCMemoryStatistics stats;
+      rtcGetMemoryStatistics(scene,stats);
+      AssertError(device,RTC_INVALID_OPERATION);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      rtcGetMemoryStatistics(scene,stats);
+      AssertNoError(device);
+      bool passed = stats.name == nullptr && stats.innerNodes > 0 && stats.leaves > 0 && stats.primRefs > 0 && stats.halfEdges > 0;
+      passed &= stats.total == stats.innerNodes + stats.leaves + stats.primRefs + stats.tessellationCache + stats.halfEdges + stats.wasted + stats.free;
+
+      /* the acceleration structures have to add up to the scene */
+      RTCMemoryStatistics sum; memset(&sum,0,sizeof(sum));
+      const size_t numAccels = rtcGetNumAccels(scene);
+      for (size_t i=0; i<numAccels; i++) 
+      {
+        RTCMemoryStatistics accel;
+        rtcGetAccelMemoryStatistics(scene,i,accel);
+        passed &= accel.name != nullptr && accel.tessellationCache == 0 && accel.halfEdges == 0;
+        sum.innerNodes += accel.innerNodes; sum.leaves += accel.leaves; sum.primRefs += accel.primRefs;
+        sum.wasted += accel.wasted; sum.free += accel.free;
+      }
+      AssertNoError(device);
+      passed &= numAccels > 0 && sum.innerNodes == stats.innerNodes && sum.leaves == stats.leaves && sum.primRefs == stats.primRefs;
+      passed &= sum.wasted == stats.wasted && sum.free == stats.free;
+
+      rtcGetAccelMemoryStatistics(scene,numAccels,stats);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct MemoryBudgetTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    MemoryBudgetTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    size_t commitWithBudget(VerifyScene& scene, size_t budget)
+    {
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,200));
+      rtcSetMemoryBudget(scene,budget);
+      rtcCommit(scene);
+      RTCMemoryStatistics stats;
+      rtcGetMemoryStatistics(scene,stats);
+      return stats.total;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* a budget between the default and the compact layout has to select a more compact layout */
+      VerifyScene scene0(device,sflags,aflags);
+      const size_t bytes0 = commitWithBudget(scene0,0);
+      VerifyScene scene1(device,RTCSceneFlags(sflags | RTC_SCENE_COMPACT),aflags);
+      const size_t bytes1 = commitWithBudget(scene1,0);
+      AssertNoError(device);
+      if (bytes1 >= bytes0) return VerifyApplication::FAILED;
+
+      VerifyScene scene2(device,sflags,aflags);
+      const size_t budget = (bytes0+bytes1)/2;
+      const size_t bytes2 = commitWithBudget(scene2,budget);
+      AssertNoError(device);
+      bool passed = bytes2 <= budget;
+
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-5.0f);
+        RTCRay ray0 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene0,ray0);
+        RTCRay ray2 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene2,ray2);
+        passed &= ray0.primID == ray2.primID;
+      }
+      AssertNoError(device);
+
+      /* a budget that cannot get met has to fail the commit */
+      VerifyScene scene3(device,sflags,aflags);
+      scene3.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,200));
+      rtcSetMemoryBudget(scene3,1024);
+      rtcCommit(scene3);
+      AssertError(device,RTC_OUT_OF_MEMORY);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct TessellationCacheTest : public VerifyApplication::Test
+  {
+    TessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* coherent scenes tessellate lazily into the cache */
+      const RTCSceneFlags sflags = RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_COHERENT);
+      VerifyScene scene0(device,sflags,aflags);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,20));
+      rtcCommit(scene0);
+      VerifyScene scene1(device,sflags,aflags);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(zero,1.0f,8,20));
+      rtcSetTessellationCacheSize(scene1,16*1024*1024);
+      rtcCommit(scene1);
+      AssertNoError(device);
+
+      RTCTessellationCacheStatistics shared0, shared1, stats1;
+      rtcGetTessellationCacheStatistics(scene0,shared0);
+      bool passed = true;
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-5.0f);
+        RTCRay ray1 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene1,ray1);
+        passed &= ray1.primID == RTC_INVALID_GEOMETRY_ID || ray1.geomID == 0;
+      }
+      AssertNoError(device);
+
+      /* rendering the scene with its own cache does not touch the shared cache */
+      rtcGetTessellationCacheStatistics(scene0,shared1);
+      rtcGetTessellationCacheStatistics(scene1,stats1);
+      passed &= shared0.hits == shared1.hits && shared0.misses == shared1.misses && shared0.allocatedBytes == shared1.allocatedBytes;
+      passed &= stats1.bytes == 16*1024*1024 && stats1.misses > 0 && stats1.hits > 0 && stats1.allocatedBytes > 0;
+
+      /* both caches produce the same hits */
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-5.0f);
+        RTCRay ray0 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene1,ray1);
+        passed &= ray0.primID == ray1.primID && ray0.tfar == ray1.tfar;
+      }
+      AssertNoError(device);
+
+      /* returning to the shared cache */
+      rtcSetTessellationCacheSize(scene1,0);
+      rtcGetTessellationCacheStatistics(scene1,stats1);
+      AssertNoError(device);
+      passed &= stats1.bytes == shared1.bytes;
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct HostTaskingTest : public VerifyApplication::Test
+  {
+    /* minimal host pool: the outermost task set is distributed over all host threads, nested task sets run on the calling thread */
+    struct HostPool
+    {
+      static const size_t numThreads = 4;
+
+      struct Job 
+      {
+        HostPool* pool;
+        size_t threadIndex;
+        size_t begin, end, blockSize;
+        RTCTaskFunc task;
+        void* taskPtr;
+        std::atomic<size_t>* next;
+      };
+
+      static __thread size_t thread_index;
+
+      static void worker(Job* job)
+      {
+        thread_index = job->threadIndex;
+        while (true) 
+        {
+          const size_t i = job->begin + job->next->fetch_add(job->blockSize);
+          if (i >= job->end) break;
+          job->task(job->taskPtr,i,min(i+job->blockSize,job->end));
+        }
+        thread_index = 0;
+      }
+
+      static void parallelFor(void* userPtr, size_t begin, size_t end, size_t blockSize, RTCTaskFunc task, void* taskPtr)
+      {
+        HostPool* pool = (HostPool*) userPtr;
+        pool->invokations++;
+        if (blockSize == 0 || blockSize > end-begin) blockSize = max(size_t(1),end-begin);
+
+        if (pool->active.exchange(true)) {
+          for (size_t i=begin; i<end; i+=blockSize) task(taskPtr,i,min(i+blockSize,end));
+          return;
+        }
+
+        std::atomic<size_t> next(0);
+        Job jobs[numThreads];
+        std::vector<thread_t> threads;
+        for (size_t t=0; t<numThreads; t++) {
+          jobs[t] = { pool, t, begin, end, blockSize, task, taskPtr, &next };
+          if (t) threads.push_back(createThread((thread_func)worker,&jobs[t],DEFAULT_STACK_SIZE,-1));
+        }
+        worker(&jobs[0]);
+        for (auto thread : threads) join(thread);
+        pool->active = false;
+      }
+
+      static size_t threadIndex(void* userPtr) {
+        return thread_index;
+      }
+
+      std::atomic<size_t> invokations;
+      std::atomic<bool> active;
+    };
+
+    HostTaskingTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      /* incomplete interfaces are rejected */
+      RTCTaskingInterface tasking = { HostPool::parallelFor, nullptr, HostPool::numThreads, nullptr };
+      rtcDeviceSetTaskingInterface(device,&tasking);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+
+      VerifyScene scene0(device,RTC_SCENE_STATIC,aflags);
+      scene0.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,200));
+      rtcCommit(scene0);
+      AssertNoError(device);
+
+      /* the same scene built on the host pool has to produce the same hits */
+      HostPool pool; 
+      pool.invokations = 0; 
+      pool.active = false;
+      tasking.threadIndex = HostPool::threadIndex;
+      tasking.userPtr = &pool;
+      rtcDeviceSetTaskingInterface(device,&tasking);
+      AssertNoError(device);
+
+      VerifyScene scene1(device,RTC_SCENE_STATIC,aflags);
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,200));
+      scene1.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(Vec3fa(3,0,0),1.0f,8,20));
+      rtcCommit(scene1);
+      AssertNoError(device);
+      bool passed = pool.invokations > 0;
+
+      rtcDeviceSetTaskingInterface(device,nullptr);
+      AssertNoError(device);
+
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,-5.0f);
+        RTCRay ray0 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene0,ray0);
+        RTCRay ray1 = makeRay(org,Vec3fa(0,0,1)); rtcIntersect(scene1,ray1);
+        passed &= ray0.primID == ray1.primID;
+      }
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  __thread size_t HostTaskingTest::HostPool::thread_index = 0;
+
+  struct InstanceRefitTest : public VerifyApplication::Test
+  {
+    float refitThreshold;
+
+    InstanceRefitTest (std::string name, int isa, float refitThreshold)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), refitThreshold(refitThreshold) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",toplevel_refit_threshold="+std::to_string(refitThreshold);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+
+      VerifyScene object(device,RTC_SCENE_STATIC,aflags);
+      object.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,0.5f,10));
+      rtcCommit(object);
+      AssertNoError(device);
+
+      /* each instance is placed into its own grid cell, such that rays along z only hit that instance */
+      const unsigned gridSize = 16;
+      const unsigned numInstances = gridSize*gridSize;
+      VerifyScene scene(device,RTC_SCENE_DYNAMIC,aflags);
+      std::vector<unsigned> cells(numInstances);
+      std::vector<Vec3fa> pos(numInstances);
+      for (unsigned i=0; i<numInstances; i++) {
+        rtcNewInstance(scene,object);
+        cells[i] = i;
+        pos[i] = Vec3fa(2.0f*float(i%gridSize),2.0f*float(i/gridSize),20.0f*random_float()-10.0f);
+      }
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t frame=0; frame<16; frame++)
+      {
+        /* mostly small motions, but every few frames the instances get shuffled between cells */
+        const bool shuffle = frame%4 == 3;
+        if (shuffle) {
+          for (unsigned i=0; i<numInstances; i++) 
+            std::swap(cells[i],cells[random_int()%numInstances]);
+        }
+        for (unsigned i=0; i<numInstances; i++) 
+        {
+          const Vec3fa jitter(0.5f*random_float()-0.25f,0.5f*random_float()-0.25f,2.0f*random_float()-1.0f);
+          if (shuffle) pos[i] = Vec3fa(2.0f*float(cells[i]%gridSize),2.0f*float(cells[i]/gridSize),20.0f*random_float()-10.0f);
+          else         pos[i] = Vec3fa(2.0f*float(cells[i]%gridSize),2.0f*float(cells[i]/gridSize),pos[i].z) + jitter;
+          const AffineSpace3fa xfm = AffineSpace3fa::translate(pos[i]);
+          rtcSetTransform(scene,i,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,(const float*)&xfm);
+          rtcUpdate(scene,i);
+        }
+        rtcCommit(scene);
+        AssertNoError(device);
+
+        for (unsigned i=0; i<numInstances; i++)
+        {
+          RTCRay ray = makeRay(pos[i]-Vec3fa(0,0,20),Vec3fa(0,0,1)); 
+          rtcIntersect(scene,ray);
+          passed &= ray.instID == i;
+          passed &= abs(ray.tfar-19.5f) < 0.1f;
+        }
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     RTCSceneFlags sflags;
@@ -3650,6 +4121,55 @@ namespace embree
     }
   };
 
+  struct SceneOverheadBenchmark : public VerifyApplication::Benchmark
+  {
+    RTCSceneFlags sflags;
+    size_t numPhi;
+    RTCDeviceRef device;
+    Ref<SceneGraph::Node> geometry;
+
+    SceneOverheadBenchmark (std::string name, int isa, RTCSceneFlags sflags, size_t numPhi)
+      : VerifyApplication::Benchmark(name,isa,"KB",false,1), sflags(sflags), numPhi(numPhi), device(nullptr) {}
+
+    static bool memoryMonitor(const ssize_t bytes, const bool /*post*/)
+    {
+      bytes_used += bytes;
+      return true;
+    }
+
+    bool setup(VerifyApplication* state) 
+    {
+      std::string cfg = state->rtcore + ",start_threads=1,set_affinity=1,isa="+stringOfISA(isa) + ",threads=" + std::to_string((long long)numThreads);
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      rtcDeviceSetErrorFunction(device,errorHandler);
+      rtcDeviceSetMemoryMonitorFunction(device,memoryMonitor);
+      geometry = SceneGraph::createTriangleSphere(zero,1.0f,numPhi);
+      return true;
+    }
+
+    /* average memory consumed by many small scenes, mostly determined by allocation granularity */
+    float benchmark(VerifyApplication* state)
+    {
+      const size_t numScenes = 64;
+      std::vector<Ref<VerifyScene>> scenes;
+      bytes_used = 0;
+      for (size_t i=0; i<numScenes; i++) {
+        scenes.push_back(new VerifyScene(device,sflags,aflags_all));
+        scenes.back()->addGeometry(RTC_GEOMETRY_STATIC,geometry);
+        rtcCommit(*scenes.back());
+      }
+      AssertNoError(device);
+      return 1E-3f*float(bytes_used)/float(numScenes);
+    }
+      
+    virtual void cleanup(VerifyApplication* state) 
+    {
+      geometry = nullptr;
+      device = nullptr;
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -3808,6 +4328,28 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_GEOMETRY_STATIC));
       groups.pop();
+
+      groups.top()->add(new SaveLoadBVHTest("save_load_bvh",isa));
+      groups.top()->add(new FileBufferTest("file_buffer",isa));
+
+      push(new TestGroup("memory_statistics",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new MemoryStatisticsTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      push(new TestGroup("memory_budget",true,true));
+      groups.top()->add(new MemoryBudgetTest("static",isa,RTC_SCENE_STATIC));
+      groups.top()->add(new MemoryBudgetTest("high_quality",isa,RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY)));
+      groups.top()->add(new MemoryBudgetTest("dynamic",isa,RTC_SCENE_DYNAMIC));
+      groups.pop();
+
+      groups.top()->add(new HostTaskingTest("host_tasking",isa));
+      groups.top()->add(new TessellationCacheTest("tessellation_cache",isa));
+
+      push(new TestGroup("instance_refit",true,true));
+      groups.top()->add(new InstanceRefitTest("default",isa,1.3f));
+      groups.top()->add(new InstanceRefitTest("always",isa,1000.0f));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,true));
       for (auto sflags : sceneFlags)
@@ -3939,6 +4481,12 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+
+        /* compact static scenes use quantized nodes that are traversed watertight also without the robust flag */
+        const RTCSceneFlags compact = RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_COMPACT);
+        for (auto imode : intersectModes) 
+          for (std::string model : watertightModels) 
+            groups.top()->add(new WatertightTest(to_string(compact,imode)+"."+model,isa,compact,imode,model,watertight_pos));
         groups.pop();
       }
 
@@ -3959,6 +4507,12 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+
+        /* compact static scenes use quantized nodes that are traversed watertight also without the robust flag */
+        const RTCSceneFlags compact = RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_COMPACT);
+        for (auto imode : intersectModes) 
+          for (std::string model : watertightModels) 
+            groups.top()->add(new WatertightTest(to_string(compact,imode)+"."+model,isa,compact,imode,model,watertight_pos));
         groups.pop();
       }
 
@@ -4143,6 +4697,13 @@ namespace embree
             groups.top()->add(new CreateGeometryBenchmark(to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
                                                           isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),false,false));
 
+      /* per scene overhead depends on the page size of the system, thus the page size is part of the name */
+      const std::string pageSize = "page"+std::to_string((long long)getPageSize()/1024)+"k";
+      groups.top()->add(new SceneOverheadBenchmark("scene_overhead_4."+pageSize+".static" ,isa,RTC_SCENE_STATIC ,1));
+      groups.top()->add(new SceneOverheadBenchmark("scene_overhead_4."+pageSize+".dynamic",isa,RTC_SCENE_DYNAMIC,1));
+      groups.top()->add(new SceneOverheadBenchmark("scene_overhead_120."+pageSize+".static" ,isa,RTC_SCENE_STATIC ,6));
+      groups.top()->add(new SceneOverheadBenchmark("scene_overhead_120."+pageSize+".dynamic",isa,RTC_SCENE_DYNAMIC,6));
+
       groups.pop(); // embree_reported_memory
 
       groups.pop(); // isa